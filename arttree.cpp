@@ -0,0 +1,690 @@
+// ----------------------------- arttree.cpp ---------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The arttree.cpp file is the implementation file for the
+// ArtTree class, the adaptive radix tree engine for string NodeData keys.
+// ---------------------------------------------------------------------
+// Notes - Walking down the tree consumes the key one byte per level plus
+// the compressed prefix of each inner node, so depth is the number of key
+// bytes already matched. Key bytes are always treated as unsigned, which
+// makes the child order, and so the output order, the same as the order
+// of the strings themselves. Node16 uses an SSE2 compare of all 16 key
+// bytes when it is available.
+// ---------------------------------------------------------------------
+#include "arttree.h"
+#include <cstring>
+#include <iostream>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// -----------------------------[Default Constructor]-----------------------------------------
+// Description: The default constructor for the ArtTree class initializes an empty tree.
+// -------------------------------------------------------------------------------------------
+ArtTree::ArtTree()
+{
+	root = nullptr;
+	keyCount = 0;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------[Copy Constructor]-------------------------------------------
+// Description: The copy constructor for the ArtTree class creates a deep copy of
+// otherArtTree, including copies of all of its node data.
+// -------------------------------------------------------------------------------------------
+ArtTree::ArtTree(const ArtTree &otherArtTree)
+{
+	root = copyHelper(otherArtTree.root);
+	keyCount = otherArtTree.keyCount;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[Destructor]----------------------------------------------
+// Description: The destructor of the ArtTree class frees all of the nodes and node data.
+// -------------------------------------------------------------------------------------------
+ArtTree::~ArtTree()
+{
+	makeEmpty();
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[makeEmpty]-----------------------------------------------
+// Description: The makeEmpty method deletes every node and every key of the tree.
+// -------------------------------------------------------------------------------------------
+void ArtTree::makeEmpty()
+{
+	emptyArtTreeHelper(root);
+	keyCount = 0;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------[emptyArtTreeHelper]-------------------------------------------
+// Description: The emptyArtTreeHelper method is the helper method for makeEmpty, it deletes
+// the children of node, its keys, and then node itself as the node type it really is.
+// -------------------------------------------------------------------------------------------
+void ArtTree::emptyArtTreeHelper(ArtNode* &node)
+{
+	if (node == nullptr)
+	{
+		return;
+	}
+
+	switch (node->type)
+	{
+		case LEAF:
+		{
+			ArtLeaf* leaf = static_cast<ArtLeaf*>(node);
+			delete leaf->data;
+			delete leaf;
+			break;
+		}
+		case NODE4:
+		{
+			ArtNode4* inner = static_cast<ArtNode4*>(node);
+			for (int i = 0; i < inner->childCount; i++)
+			{
+				emptyArtTreeHelper(inner->children[i]);
+			}
+			delete inner->terminal;
+			delete inner;
+			break;
+		}
+		case NODE16:
+		{
+			ArtNode16* inner = static_cast<ArtNode16*>(node);
+			for (int i = 0; i < inner->childCount; i++)
+			{
+				emptyArtTreeHelper(inner->children[i]);
+			}
+			delete inner->terminal;
+			delete inner;
+			break;
+		}
+		case NODE48:
+		{
+			ArtNode48* inner = static_cast<ArtNode48*>(node);
+			for (int i = 0; i < inner->childCount; i++)
+			{
+				emptyArtTreeHelper(inner->children[i]);
+			}
+			delete inner->terminal;
+			delete inner;
+			break;
+		}
+		case NODE256:
+		{
+			ArtNode256* inner = static_cast<ArtNode256*>(node);
+			for (int i = 0; i < 256; i++)
+			{
+				emptyArtTreeHelper(inner->children[i]);
+			}
+			delete inner->terminal;
+			delete inner;
+			break;
+		}
+	}
+	node = nullptr;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[copyHelper]----------------------------------------------
+// Description: The copyHelper method returns a deep copy of otherNode and everything below
+// it, keeping the same node types and giving the copy its own node data.
+// -------------------------------------------------------------------------------------------
+ArtTree::ArtNode* ArtTree::copyHelper(const ArtNode* otherNode) const
+{
+	if (otherNode == nullptr)
+	{
+		return nullptr;
+	}
+
+	switch (otherNode->type)
+	{
+		case LEAF:
+			return newLeaf(new NodeData(*static_cast<const ArtLeaf*>(otherNode)->data));
+		case NODE4:
+		{
+			ArtNode4* newNode = new ArtNode4(*static_cast<const ArtNode4*>(otherNode));
+			for (int i = 0; i < newNode->childCount; i++)
+			{
+				newNode->children[i] = copyHelper(newNode->children[i]);
+			}
+			newNode->terminal = newNode->terminal ? new NodeData(*newNode->terminal) : nullptr;
+			return newNode;
+		}
+		case NODE16:
+		{
+			ArtNode16* newNode = new ArtNode16(*static_cast<const ArtNode16*>(otherNode));
+			for (int i = 0; i < newNode->childCount; i++)
+			{
+				newNode->children[i] = copyHelper(newNode->children[i]);
+			}
+			newNode->terminal = newNode->terminal ? new NodeData(*newNode->terminal) : nullptr;
+			return newNode;
+		}
+		case NODE48:
+		{
+			ArtNode48* newNode = new ArtNode48(*static_cast<const ArtNode48*>(otherNode));
+			for (int i = 0; i < newNode->childCount; i++)
+			{
+				newNode->children[i] = copyHelper(newNode->children[i]);
+			}
+			newNode->terminal = newNode->terminal ? new NodeData(*newNode->terminal) : nullptr;
+			return newNode;
+		}
+		default:
+		{
+			ArtNode256* newNode = new ArtNode256(*static_cast<const ArtNode256*>(otherNode));
+			for (int i = 0; i < 256; i++)
+			{
+				newNode->children[i] = copyHelper(newNode->children[i]);
+			}
+			newNode->terminal = newNode->terminal ? new NodeData(*newNode->terminal) : nullptr;
+			return newNode;
+		}
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[isEmpty]----------------------------------------------
+// Description: The isEmpty method returns true if the tree holds no keys.
+// -------------------------------------------------------------------------------------------
+bool ArtTree::isEmpty() const
+{
+	return root == nullptr;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[size]------------------------------------------------
+// Description: The size method returns the number of keys in the tree.
+// -------------------------------------------------------------------------------------------
+int ArtTree::size() const
+{
+	return keyCount;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator=]----------------------------------------------
+// Description: The overloaded assignment operator replaces the contents of this tree with
+// a deep copy of otherArtTree, self-assignment leaves the tree unchanged.
+// -------------------------------------------------------------------------------------------
+ArtTree& ArtTree::operator=(const ArtTree &otherArtTree)
+{
+	if (this != &otherArtTree)
+	{
+		makeEmpty();
+		root = copyHelper(otherArtTree.root);
+		keyCount = otherArtTree.keyCount;
+	}
+	return *this;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator<<]---------------------------------------------
+// Description: The overloaded output operator prints the keys of the tree in sorted order
+// separated by spaces, followed by a newline.
+// -------------------------------------------------------------------------------------------
+ostream& operator<<(ostream& out, const ArtTree &artTree)
+{
+	artTree.inorderHelper(out, artTree.root);
+	out << endl;
+	return out;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[inorderHelper]-------------------------------------------
+// Description: The inorderHelper method prints the keys below node in sorted order. The
+// terminal key of an inner node is a prefix of every other key below it, so it comes first,
+// then the children are visited in increasing key byte order.
+// -------------------------------------------------------------------------------------------
+void ArtTree::inorderHelper(ostream& out, const ArtNode* node) const
+{
+	if (node == nullptr)
+	{
+		return;
+	}
+
+	if (node->type == LEAF)
+	{
+		out << *static_cast<const ArtLeaf*>(node)->data << " ";
+		return;
+	}
+
+	const ArtInner* inner = static_cast<const ArtInner*>(node);
+	if (inner->terminal != nullptr)
+	{
+		out << *inner->terminal << " ";
+	}
+
+	switch (node->type)
+	{
+		case NODE4:
+			for (int i = 0; i < inner->childCount; i++)
+			{
+				inorderHelper(out, static_cast<const ArtNode4*>(node)->children[i]);
+			}
+			break;
+		case NODE16:
+			for (int i = 0; i < inner->childCount; i++)
+			{
+				inorderHelper(out, static_cast<const ArtNode16*>(node)->children[i]);
+			}
+			break;
+		case NODE48:
+		{
+			const ArtNode48* node48 = static_cast<const ArtNode48*>(node);
+			for (int keyByte = 0; keyByte < 256; keyByte++)
+			{
+				if (node48->childIndex[keyByte] != 0)
+				{
+					inorderHelper(out, node48->children[node48->childIndex[keyByte] - 1]);
+				}
+			}
+			break;
+		}
+		case NODE256:
+			for (int keyByte = 0; keyByte < 256; keyByte++)
+			{
+				inorderHelper(out, static_cast<const ArtNode256*>(node)->children[keyByte]);
+			}
+			break;
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[newLeaf]-----------------------------------------------
+// Description: The newLeaf method returns a new leaf holding data.
+// -------------------------------------------------------------------------------------------
+ArtTree::ArtLeaf* ArtTree::newLeaf(NodeData* data) const
+{
+	ArtLeaf* leaf = new ArtLeaf();
+	leaf->type = LEAF;
+	leaf->data = data;
+	return leaf;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[newNode4]----------------------------------------------
+// Description: The newNode4 method returns a new empty Node4 with the given prefix.
+// -------------------------------------------------------------------------------------------
+ArtTree::ArtNode4* ArtTree::newNode4(const string& prefix) const
+{
+	ArtNode4* node = new ArtNode4();
+	node->type = NODE4;
+	node->prefix = prefix;
+	node->terminal = nullptr;
+	node->childCount = 0;
+	return node;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[copyInnerHeader]-------------------------------------------
+// Description: The copyInnerHeader method moves the prefix, terminal key and child count of
+// oldNode into newNode when an inner node grows into a larger node type.
+// -------------------------------------------------------------------------------------------
+void ArtTree::copyInnerHeader(ArtInner* newNode, const ArtInner* oldNode) const
+{
+	newNode->prefix = oldNode->prefix;
+	newNode->terminal = oldNode->terminal;
+	newNode->childCount = oldNode->childCount;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[findChild]----------------------------------------------
+// Description: The findChild method returns the address of the child pointer of node for
+// keyByte, so the caller can follow it or replace it, or nullptr if there is no such child.
+// -------------------------------------------------------------------------------------------
+ArtTree::ArtNode** ArtTree::findChild(ArtInner* node, uint8_t keyByte) const
+{
+	switch (node->type)
+	{
+		case NODE4:
+		{
+			ArtNode4* node4 = static_cast<ArtNode4*>(node);
+			for (int i = 0; i < node4->childCount; i++)
+			{
+				if (node4->keys[i] == keyByte)
+				{
+					return &node4->children[i];
+				}
+			}
+			return nullptr;
+		}
+		case NODE16:
+		{
+			ArtNode16* node16 = static_cast<ArtNode16*>(node);
+#if defined(__SSE2__)
+			// Compare keyByte with all 16 key bytes at once and ignore the unused slots
+			__m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(keyByte)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(node16->keys)));
+			unsigned matchMask = static_cast<unsigned>(_mm_movemask_epi8(matches)) & ((1u << node16->childCount) - 1);
+			if (matchMask != 0)
+			{
+				return &node16->children[__builtin_ctz(matchMask)];
+			}
+#else
+			for (int i = 0; i < node16->childCount; i++)
+			{
+				if (node16->keys[i] == keyByte)
+				{
+					return &node16->children[i];
+				}
+			}
+#endif
+			return nullptr;
+		}
+		case NODE48:
+		{
+			ArtNode48* node48 = static_cast<ArtNode48*>(node);
+			if (node48->childIndex[keyByte] != 0)
+			{
+				return &node48->children[node48->childIndex[keyByte] - 1];
+			}
+			return nullptr;
+		}
+		default:
+		{
+			ArtNode256* node256 = static_cast<ArtNode256*>(node);
+			if (node256->children[keyByte] != nullptr)
+			{
+				return &node256->children[keyByte];
+			}
+			return nullptr;
+		}
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[addChild]----------------------------------------------
+// Description: The addChild method adds child under keyByte to the inner node at nodeRef,
+// which must not already have a child for keyByte. A full node is first replaced by the
+// next larger node type, and nodeRef is updated to point at the replacement.
+// -------------------------------------------------------------------------------------------
+void ArtTree::addChild(ArtNode* &nodeRef, uint8_t keyByte, ArtNode* child)
+{
+	switch (nodeRef->type)
+	{
+		case NODE4:
+		{
+			ArtNode4* node4 = static_cast<ArtNode4*>(nodeRef);
+			if (node4->childCount < 4)
+			{
+				// Shift the larger key bytes over to keep the keys sorted
+				int position = node4->childCount;
+				while (position > 0 && node4->keys[position - 1] > keyByte)
+				{
+					node4->keys[position] = node4->keys[position - 1];
+					node4->children[position] = node4->children[position - 1];
+					position--;
+				}
+				node4->keys[position] = keyByte;
+				node4->children[position] = child;
+				node4->childCount++;
+				return;
+			}
+
+			// Grow into a Node16 with the same sorted keys, then add to that
+			ArtNode16* node16 = new ArtNode16();
+			node16->type = NODE16;
+			copyInnerHeader(node16, node4);
+			memcpy(node16->keys, node4->keys, sizeof(node4->keys));
+			memcpy(node16->children, node4->children, sizeof(node4->children));
+			delete node4;
+			nodeRef = node16;
+			addChild(nodeRef, keyByte, child);
+			return;
+		}
+		case NODE16:
+		{
+			ArtNode16* node16 = static_cast<ArtNode16*>(nodeRef);
+			if (node16->childCount < 16)
+			{
+				int position = node16->childCount;
+				while (position > 0 && node16->keys[position - 1] > keyByte)
+				{
+					node16->keys[position] = node16->keys[position - 1];
+					node16->children[position] = node16->children[position - 1];
+					position--;
+				}
+				node16->keys[position] = keyByte;
+				node16->children[position] = child;
+				node16->childCount++;
+				return;
+			}
+
+			// Grow into a Node48, where the key bytes index into the children
+			ArtNode48* node48 = new ArtNode48();
+			node48->type = NODE48;
+			copyInnerHeader(node48, node16);
+			for (int i = 0; i < 16; i++)
+			{
+				node48->children[i] = node16->children[i];
+				node48->childIndex[node16->keys[i]] = static_cast<uint8_t>(i + 1);
+			}
+			delete node16;
+			nodeRef = node48;
+			addChild(nodeRef, keyByte, child);
+			return;
+		}
+		case NODE48:
+		{
+			ArtNode48* node48 = static_cast<ArtNode48*>(nodeRef);
+			if (node48->childCount < 48)
+			{
+				node48->children[node48->childCount] = child;
+				node48->childIndex[keyByte] = static_cast<uint8_t>(node48->childCount + 1);
+				node48->childCount++;
+				return;
+			}
+
+			// Grow into a Node256 indexed directly by key byte
+			ArtNode256* node256 = new ArtNode256();
+			node256->type = NODE256;
+			copyInnerHeader(node256, node48);
+			for (int i = 0; i < 256; i++)
+			{
+				if (node48->childIndex[i] != 0)
+				{
+					node256->children[i] = node48->children[node48->childIndex[i] - 1];
+				}
+			}
+			delete node48;
+			nodeRef = node256;
+			addChild(nodeRef, keyByte, child);
+			return;
+		}
+		default:
+		{
+			ArtNode256* node256 = static_cast<ArtNode256*>(nodeRef);
+			node256->children[keyByte] = child;
+			node256->childCount++;
+			return;
+		}
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[insert]-----------------------------------------------
+// Description: The insert method inserts newNodeData into the tree and returns true, or
+// returns false without taking ownership of newNodeData if its key is already in the tree.
+// A leaf that is reached is split into a Node4 over the bytes the two keys share, and an
+// inner node whose prefix does not fully match is split at the first differing byte.
+// -------------------------------------------------------------------------------------------
+bool ArtTree::insert(NodeData* newNodeData)
+{
+	const string& key = newNodeData->getData();
+	ArtNode** nodeRef = &root;
+	size_t depth = 0;
+
+	for (;;)
+	{
+		ArtNode* node = *nodeRef;
+
+		// An empty spot, only possible for the root of an empty tree
+		if (node == nullptr)
+		{
+			*nodeRef = newLeaf(newNodeData);
+			keyCount++;
+			return true;
+		}
+
+		// A leaf, either it is the same key or the two keys need a Node4 to tell them apart
+		if (node->type == LEAF)
+		{
+			ArtLeaf* leaf = static_cast<ArtLeaf*>(node);
+			const string& leafKey = leaf->data->getData();
+			if (leafKey == key)
+			{
+				return false;
+			}
+
+			// Count the bytes after depth that both keys share, they become the Node4's prefix
+			size_t sharedLength = 0;
+			while (depth + sharedLength < key.size() && depth + sharedLength < leafKey.size() &&
+				key[depth + sharedLength] == leafKey[depth + sharedLength])
+			{
+				sharedLength++;
+			}
+
+			ArtNode* splitNode = newNode4(key.substr(depth, sharedLength));
+			size_t splitDepth = depth + sharedLength;
+
+			// A key that ends at the split becomes the terminal key, the other hangs under its next byte
+			if (leafKey.size() == splitDepth)
+			{
+				static_cast<ArtInner*>(splitNode)->terminal = leaf->data;
+				delete leaf;
+			}
+			else
+			{
+				addChild(splitNode, static_cast<uint8_t>(leafKey[splitDepth]), leaf);
+			}
+
+			if (key.size() == splitDepth)
+			{
+				static_cast<ArtInner*>(splitNode)->terminal = newNodeData;
+			}
+			else
+			{
+				addChild(splitNode, static_cast<uint8_t>(key[splitDepth]), newLeaf(newNodeData));
+			}
+
+			*nodeRef = splitNode;
+			keyCount++;
+			return true;
+		}
+
+		// An inner node, find how much of its prefix the key matches
+		ArtInner* inner = static_cast<ArtInner*>(node);
+		size_t prefixLength = inner->prefix.size();
+		size_t matchLength = 0;
+		while (matchLength < prefixLength && depth + matchLength < key.size() &&
+			key[depth + matchLength] == inner->prefix[matchLength])
+		{
+			matchLength++;
+		}
+
+		// The key leaves the prefix part way, so a Node4 holding the matched part goes above the
+		// inner node, which keeps the rest of its prefix after the byte it is now found under
+		if (matchLength < prefixLength)
+		{
+			ArtNode* splitNode = newNode4(inner->prefix.substr(0, matchLength));
+			uint8_t innerByte = static_cast<uint8_t>(inner->prefix[matchLength]);
+			inner->prefix.erase(0, matchLength + 1);
+			addChild(splitNode, innerByte, inner);
+
+			if (depth + matchLength == key.size())
+			{
+				static_cast<ArtInner*>(splitNode)->terminal = newNodeData;
+			}
+			else
+			{
+				addChild(splitNode, static_cast<uint8_t>(key[depth + matchLength]), newLeaf(newNodeData));
+			}
+
+			*nodeRef = splitNode;
+			keyCount++;
+			return true;
+		}
+		depth += prefixLength;
+
+		// The key ends exactly at this node
+		if (depth == key.size())
+		{
+			if (inner->terminal != nullptr)
+			{
+				return false;
+			}
+			inner->terminal = newNodeData;
+			keyCount++;
+			return true;
+		}
+
+		// Follow the child for the next key byte, or add a leaf there if there is none
+		uint8_t keyByte = static_cast<uint8_t>(key[depth]);
+		ArtNode** childRef = findChild(inner, keyByte);
+		if (childRef == nullptr)
+		{
+			addChild(*nodeRef, keyByte, newLeaf(newNodeData));
+			keyCount++;
+			return true;
+		}
+		nodeRef = childRef;
+		depth++;
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[retrieve]----------------------------------------------
+// Description: The retrieve method searches the tree for targetNodeData, it sets
+// retrievedNodeData to the stored node data and returns true if it was found, otherwise it
+// sets retrievedNodeData to nullptr and returns false. Each inner node checks its prefix
+// and then follows one key byte, and the full key is only compared once, at the leaf.
+// -------------------------------------------------------------------------------------------
+bool ArtTree::retrieve(const NodeData &targetNodeData, NodeData* &retrievedNodeData) const
+{
+	const string& key = targetNodeData.getData();
+	ArtNode* node = root;
+	size_t depth = 0;
+	retrievedNodeData = nullptr;
+
+	while (node != nullptr)
+	{
+		if (node->type == LEAF)
+		{
+			ArtLeaf* leaf = static_cast<ArtLeaf*>(node);
+			if (leaf->data->getData() == key)
+			{
+				retrievedNodeData = leaf->data;
+				return true;
+			}
+			return false;
+		}
+
+		// The key must continue with the node's whole prefix
+		ArtInner* inner = static_cast<ArtInner*>(node);
+		size_t prefixLength = inner->prefix.size();
+		if (key.size() < depth + prefixLength || key.compare(depth, prefixLength, inner->prefix) != 0)
+		{
+			return false;
+		}
+		depth += prefixLength;
+
+		if (depth == key.size())
+		{
+			retrievedNodeData = inner->terminal;
+			return retrievedNodeData != nullptr;
+		}
+
+		ArtNode** childRef = findChild(inner, static_cast<uint8_t>(key[depth]));
+		node = (childRef != nullptr) ? *childRef : nullptr;
+		depth++;
+	}
+
+	return false;
+}
+// -------------------------------------------------------------------------------------------
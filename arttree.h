@@ -0,0 +1,114 @@
+// ----------------------------- arttree.h -----------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The arttree.h file is the header file for the ArtTree class,
+// an adaptive radix tree over the strings of NodeData keys. It has the
+// same insert, retrieve, isEmpty, makeEmpty and ordered output interface
+// as BinTree, but a lookup costs one step per key byte instead of one
+// full string comparison per tree level.
+// ---------------------------------------------------------------------
+// Notes - Inner nodes come in four sizes (Node4, Node16, Node48, Node256)
+// and grow into the next size when they run out of child slots, so sparse
+// levels stay small and dense levels are a direct array index. Runs of key
+// bytes that have no branching are stored once as the prefix of an inner
+// node (path compression), and a subtree with a single key is just a leaf
+// holding its NodeData. A key that ends at an inner node, because it is a
+// prefix of longer keys, is stored as that node's terminal key.
+// ---------------------------------------------------------------------
+#ifndef ART_TREE_H
+#define ART_TREE_H
+#include "nodedata.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+using namespace std;
+
+class ArtTree {
+
+    private:
+        // The kinds of nodes in the tree, the inner nodes are named after their child capacity
+        enum NodeType { LEAF, NODE4, NODE16, NODE48, NODE256 };
+
+        // The ArtNode struct is the common start of every node, its type says what it really is
+        struct ArtNode {
+            uint8_t type;
+        };
+
+        // A leaf holds one key
+        struct ArtLeaf : ArtNode {
+            NodeData* data;
+        };
+
+        // The ArtInner struct is the common part of the inner nodes, the compressed prefix bytes
+        // that every key below the node shares, the key that ends at this node (or nullptr),
+        // and the number of children
+        struct ArtInner : ArtNode {
+            string prefix;
+            NodeData* terminal;
+            int childCount;
+        };
+
+        // Node4 and Node16 keep their key bytes sorted, with children in matching order
+        struct ArtNode4 : ArtInner {
+            uint8_t keys[4];
+            ArtNode* children[4];
+        };
+
+        struct ArtNode16 : ArtInner {
+            uint8_t keys[16];
+            ArtNode* children[16];
+        };
+
+        // Node48 maps each key byte to 1 + its slot in children, 0 means no child
+        struct ArtNode48 : ArtInner {
+            uint8_t childIndex[256];
+            ArtNode* children[48];
+        };
+
+        // Node256 is indexed directly by the key byte
+        struct ArtNode256 : ArtInner {
+            ArtNode* children[256];
+        };
+
+        // Pointer to the root node of the tree, and the number of keys in the tree
+        ArtNode* root;
+        int keyCount;
+
+    // Helper methods for creating, finding and adding children, and growing inner nodes
+    ArtLeaf* newLeaf(NodeData* data) const;
+    ArtNode4* newNode4(const string& prefix) const;
+    ArtNode** findChild(ArtInner* node, uint8_t keyByte) const;
+    void addChild(ArtNode* &nodeRef, uint8_t keyByte, ArtNode* child);
+    void copyInnerHeader(ArtInner* newNode, const ArtInner* oldNode) const;
+
+    // Helper methods for the destructor, the copy constructor and the output operator
+    void emptyArtTreeHelper(ArtNode* &node);
+    ArtNode* copyHelper(const ArtNode* otherNode) const;
+    void inorderHelper(ostream& out, const ArtNode* node) const;
+
+    public:
+        // Radix tree constructor, copy constructor, and destructor
+        ArtTree();
+        ArtTree(const ArtTree &otherArtTree);
+        ~ArtTree();
+
+        // makeEmpty deletes all of the nodes and node data in the tree
+        void makeEmpty();
+
+        // isEmpty checks to see if the tree is empty, size returns the number of keys
+        bool isEmpty() const;
+        int size() const;
+
+        // Overloaded = and << operators, << prints the keys in sorted order
+        ArtTree& operator=(const ArtTree &otherArtTree);
+        friend ostream& operator<<(ostream& out, const ArtTree &artTree);
+
+        // Insert and retrieve methods, insert takes ownership of newNodeData only when it returns true
+        bool insert(NodeData* newNodeData);
+        bool retrieve(const NodeData &targetNodeData, NodeData* &retrievedNodeData) const;
+};
+
+#endif
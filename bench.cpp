@@ -0,0 +1,477 @@
+// ----------------------------- bench.cpp -----------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The bench.cpp file is the benchmark driver for the BinTree
+// class. It times insert, retrieve, retrieveBatch, getHeight, the copy
+// constructor, operator==, bstreeToArray with arrayToBSTree, and makeEmpty
+// over several key distributions and tree sizes, along with insert and
+// retrieve on the ArtTree and on the disk-backed PagedBinTree, and prints
+// the results as CSV or JSON so that runs of different versions can be
+// compared.
+// ---------------------------------------------------------------------
+// Notes - Build it with "make bench", which links it with the same tree
+// sources as the lab2 driver (and -pthread, for the ingest pipeline).
+// Usage: bench [--sizes 1000,10000,...] [--distributions
+// sorted,reverse,random,zipf,prefix,url,words] [--format csv|json]
+// [--repeat R] [--seed S] [--degenerate-cap N] [--paged-file F]. The
+// keys come from a seeded generator, so a run with the same options
+// always times the same keys. Each measurement is repeated R times on a
+// fresh tree and the fastest run is reported. Sorted and reverse keys
+// build a tree that is one long path, where insert takes quadratic time
+// and the recursive methods recurse once per key, so those two
+// distributions are skipped above the degenerate cap. getHeight
+// searches the whole tree, so it is timed on a fixed sample of keys,
+// and bstreeToArray and arrayToBSTree work on at most 100 keys, so they
+// are timed on a tree of the first 100 keys. retrieveBatch does the
+// same lookups as retrieve, in calls of RETRIEVE_BATCH keys. The
+// PagedBinTree is kept in the paged file, which is replaced on every
+// run and removed at the end, and its lookups are timed with a cache
+// that holds the whole tree (warm) and with a cache of
+// PAGED_SMALL_CACHE pages, which has to go to the file.
+// ---------------------------------------------------------------------
+#include "arttree.h"
+#include "bintree.h"
+#include "pagedtree.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+const int ARRAYSIZE = 100;                   // capacity of the bstreeToArray array
+const int HEIGHT_SAMPLE = 64;                // keys that getHeight is timed on
+const int RETRIEVE_BATCH = 256;              // lookups handed to each retrieveBatch call
+const size_t PAGED_SMALL_CACHE = 64;         // pages in the cache of the small cache lookups
+const double ZIPF_EXPONENT = 1.0;            // skew of the zipf distribution
+const char* const SHARED_PREFIX = "https://www.example.com/catalog/products/category/subcategory/item/";
+const int URL_HOSTS = 40;                    // hosts that the url keys are spread over
+
+// Syllables that the words keys and the path segments of the url keys are made of
+const char* const SYLLABLES[] = { "an", "ba", "con", "de", "er", "fa", "gen", "hi", "in", "ka",
+	"la", "men", "no", "or", "pre", "qui", "re", "sta", "ti", "un", "ver", "wa", "xe", "yo", "zu" };
+const int SYLLABLE_COUNT = sizeof(SYLLABLES) / sizeof(SYLLABLES[0]);
+
+// The BenchOptions struct holds the command line settings of a run
+struct BenchOptions {
+	vector<long long> sizes = { 1000, 10000, 100000, 1000000 };
+	vector<string> distributions = { "sorted", "reverse", "random", "zipf", "prefix", "url", "words" };
+	string format = "csv";
+	int repeat = 3;
+	unsigned long long seed = 343;
+	long long degenerateCap = 20000;
+	string pagedFile = "bench_paged.db";
+};
+
+// The BenchResult struct is one timed operation, seconds is for all of its operations together
+struct BenchResult {
+	string distribution;
+	long long size;
+	string operation;
+	long long operations;
+	double seconds;
+};
+
+// global function prototypes
+bool parseOptions(int, char*[], BenchOptions&);
+vector<string> makeKeys(const string&, long long, unsigned long long);
+void benchDistribution(const string&, long long, const BenchOptions&, vector<BenchResult>&);
+void printCsv(const vector<BenchResult>&);
+void printJson(const vector<BenchResult>&, const BenchOptions&);
+
+int main(int argc, char* argv[]) {
+	BenchOptions options;
+	if (!parseOptions(argc, argv, options)) {
+		return 1;
+	}
+
+	vector<BenchResult> results;
+	for (const string& distribution : options.distributions) {
+		for (long long size : options.sizes) {
+			bool degenerate = (distribution == "sorted" || distribution == "reverse");
+			if (degenerate && size > options.degenerateCap) {
+				cerr << "skipping " << distribution << " at " << size
+					<< " keys (above --degenerate-cap " << options.degenerateCap << ")" << endl;
+				continue;
+			}
+			cerr << "timing " << distribution << " at " << size << " keys" << endl;
+			benchDistribution(distribution, size, options, results);
+		}
+	}
+
+	if (options.format == "json") {
+		printJson(results, options);
+	}
+	else {
+		printCsv(results);
+	}
+	return 0;
+}
+
+// ---------------------------------[parseOptions]--------------------------------------------
+// Description: The parseOptions global method reads the command line into options, it
+// prints the usage and returns false for an unknown option or a bad value.
+// -------------------------------------------------------------------------------------------
+bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+	const string usage = "usage: bench [--sizes N,N,...] [--distributions sorted,reverse,random,zipf,prefix,url,words] "
+		"[--format csv|json] [--repeat R] [--seed S] [--degenerate-cap N] [--paged-file F]";
+
+	for (int i = 1; i < argc; i++) {
+		string option = argv[i];
+		if (i + 1 >= argc) {
+			cerr << usage << endl;
+			return false;
+		}
+		string value = argv[++i];
+
+		// Splits a comma separated value into its items
+		vector<string> items;
+		stringstream valueStream(value);
+		for (string item; getline(valueStream, item, ',');) {
+			if (!item.empty()) {
+				items.push_back(item);
+			}
+		}
+
+		if (option == "--sizes") {
+			options.sizes.clear();
+			for (const string& item : items) {
+				// Sizes may be written as 1e6 as well as 1000000
+				long long size = static_cast<long long>(atof(item.c_str()));
+				if (size <= 0) {
+					cerr << "bad size " << item << endl;
+					return false;
+				}
+				options.sizes.push_back(size);
+			}
+		}
+		else if (option == "--distributions") {
+			for (const string& item : items) {
+				if (item != "sorted" && item != "reverse" && item != "random" && item != "zipf" && item != "prefix"
+					&& item != "url" && item != "words") {
+					cerr << "unknown distribution " << item << endl;
+					return false;
+				}
+			}
+			options.distributions = items;
+		}
+		else if (option == "--format" && (value == "csv" || value == "json")) {
+			options.format = value;
+		}
+		else if (option == "--repeat" && atoi(value.c_str()) > 0) {
+			options.repeat = atoi(value.c_str());
+		}
+		else if (option == "--seed") {
+			options.seed = strtoull(value.c_str(), nullptr, 10);
+		}
+		else if (option == "--degenerate-cap") {
+			options.degenerateCap = atoll(value.c_str());
+		}
+		else if (option == "--paged-file") {
+			options.pagedFile = value;
+		}
+		else {
+			cerr << usage << endl;
+			return false;
+		}
+	}
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[makeKeys]----------------------------------------------
+// Description: The makeKeys global method returns the size keys of one distribution, in the
+// order they are inserted. sorted and reverse are distinct fixed width numbers in increasing
+// and decreasing order, random is distinct random numbers in random order, zipf draws from
+// a vocabulary of size words where word k is drawn in proportion to 1 / k (so most keys are
+// repeats), prefix is distinct random ids behind a long prefix that every key shares, url is
+// distinct web addresses on a few hosts with made up word paths, and words is distinct made
+// up dictionary words of one to five syllables.
+// -------------------------------------------------------------------------------------------
+vector<string> makeKeys(const string& distribution, long long size, unsigned long long seed) {
+	mt19937_64 generator(seed);
+	vector<string> keys;
+	keys.reserve(static_cast<size_t>(size));
+
+	// Formats a number as a fixed width key, so that string order is number order
+	auto numberKey = [](unsigned long long number) {
+		string digits = to_string(number);
+		return "key" + string(digits.size() < 20 ? 20 - digits.size() : 0, '0') + digits;
+	};
+
+	// Makes a word of syllableTotal random syllables
+	auto makeWord = [&](int syllableTotal) {
+		string word;
+		for (int syllable = 0; syllable < syllableTotal; syllable++) {
+			word += SYLLABLES[generator() % SYLLABLE_COUNT];
+		}
+		return word;
+	};
+
+	if (distribution == "sorted" || distribution == "reverse") {
+		for (long long i = 0; i < size; i++) {
+			keys.push_back(numberKey(static_cast<unsigned long long>(distribution == "sorted" ? i : size - 1 - i)));
+		}
+	}
+	else if (distribution == "random" || distribution == "prefix") {
+		// Spreading the numbers 0 .. size - 1 with an odd multiplier keeps them distinct
+		for (long long i = 0; i < size; i++) {
+			unsigned long long number = static_cast<unsigned long long>(i) * 0x9E3779B97F4A7C15ull;
+			keys.push_back(distribution == "random" ? numberKey(number) : SHARED_PREFIX + numberKey(number));
+		}
+		shuffle(keys.begin(), keys.end(), generator);
+	}
+	else if (distribution == "zipf") {
+		// Cumulative weights of the vocabulary, a draw is a binary search for a uniform number
+		vector<double> cumulativeWeights(static_cast<size_t>(size));
+		double totalWeight = 0;
+		for (long long rank = 0; rank < size; rank++) {
+			totalWeight += 1.0 / pow(static_cast<double>(rank + 1), ZIPF_EXPONENT);
+			cumulativeWeights[static_cast<size_t>(rank)] = totalWeight;
+		}
+		uniform_real_distribution<double> uniform(0, totalWeight);
+		for (long long i = 0; i < size; i++) {
+			size_t rank = lower_bound(cumulativeWeights.begin(), cumulativeWeights.end(), uniform(generator)) - cumulativeWeights.begin();
+			keys.push_back(numberKey(static_cast<unsigned long long>(rank) * 0x9E3779B97F4A7C15ull));
+		}
+	}
+	else if (distribution == "url") {
+		// The number at the end keeps the addresses distinct, as a page id would
+		for (long long i = 0; i < size; i++) {
+			string url = "https://www.site" + to_string(generator() % URL_HOSTS) + ".com";
+			for (int segment = 1 + static_cast<int>(generator() % 3); segment > 0; segment--) {
+				url += "/" + makeWord(2 + static_cast<int>(generator() % 2));
+			}
+			keys.push_back(url + "/" + to_string(i));
+		}
+		shuffle(keys.begin(), keys.end(), generator);
+	}
+	else if (distribution == "words") {
+		// Words are drawn until size distinct ones are found, there are far more than enough
+		unordered_set<string> seenWords;
+		while (static_cast<long long>(keys.size()) < size) {
+			string word = makeWord(1 + static_cast<int>(generator() % 5));
+			if (seenWords.insert(word).second) {
+				keys.push_back(std::move(word));
+			}
+		}
+	}
+	return keys;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[buildTree]----------------------------------------------
+// Description: The buildTree global method inserts keys into a BinTree or ArtTree the way the
+// lab2 driver does, one new NodeData per key that is deleted again if it is a duplicate.
+// -------------------------------------------------------------------------------------------
+template <class Tree>
+static void buildTree(Tree& tree, const vector<string>& keys) {
+	for (const string& key : keys) {
+		NodeData* newNodeData = new NodeData(key);
+		if (!tree.insert(newNodeData)) {
+			delete newNodeData;
+		}
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[bestOfRepeats]--------------------------------------------
+// Description: The bestOfRepeats global method runs setup and then timedPart repeat times,
+// timing only timedPart, and returns the fastest time in seconds.
+// -------------------------------------------------------------------------------------------
+template <class Setup, class TimedPart>
+static double bestOfRepeats(int repeat, Setup setup, TimedPart timedPart) {
+	double bestSeconds = 0;
+	for (int run = 0; run < repeat; run++) {
+		setup();
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		timedPart();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		if (run == 0 || seconds < bestSeconds) {
+			bestSeconds = seconds;
+		}
+	}
+	return bestSeconds;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------[benchDistribution]------------------------------------------
+// Description: The benchDistribution global method times every BinTree operation on the
+// keys of one distribution and size, and adds one result per operation to results. The
+// lookups use NodeData objects built before the timing starts, and a checksum of what the
+// lookups return is kept so the compiler cannot drop them.
+// -------------------------------------------------------------------------------------------
+void benchDistribution(const string& distribution, long long size, const BenchOptions& options, vector<BenchResult>& results) {
+	vector<string> keys = makeKeys(distribution, size, options.seed);
+	auto addResult = [&](const string& operation, long long operations, double seconds) {
+		results.push_back({ distribution, size, operation, operations, seconds });
+	};
+
+	// insert, each run starts from an empty tree
+	BinTree tree;
+	double seconds = bestOfRepeats(options.repeat, [&] { tree.makeEmpty(); }, [&] { buildTree(tree, keys); });
+	addResult("insert", size, seconds);
+
+	// retrieve, every key once in a shuffled order
+	vector<NodeData> queries(keys.begin(), keys.end());
+	shuffle(queries.begin(), queries.end(), mt19937_64(options.seed + 1));
+	unsigned long long checksum = 0;
+	seconds = bestOfRepeats(options.repeat, [] {}, [&] {
+		NodeData* retrievedNodeData;
+		for (const NodeData& query : queries) {
+			checksum += tree.retrieve(query, retrievedNodeData) ? 1 : 0;
+		}
+	});
+	addResult("retrieve", static_cast<long long>(queries.size()), seconds);
+
+	// retrieveBatch, the same lookups in the same order as retrieve, RETRIEVE_BATCH at a time
+	vector<NodeData*> batchResults(queries.size());
+	seconds = bestOfRepeats(options.repeat, [] {}, [&] {
+		for (size_t first = 0; first < queries.size(); first += RETRIEVE_BATCH) {
+			int batchCount = static_cast<int>(min(queries.size() - first, static_cast<size_t>(RETRIEVE_BATCH)));
+			checksum += static_cast<unsigned long long>(tree.retrieveBatch(&queries[first], &batchResults[first], batchCount));
+		}
+	});
+	addResult("retrieveBatch", static_cast<long long>(queries.size()), seconds);
+
+	// getHeight, on a sample of the keys since each call searches the whole tree
+	size_t heightSamples = min(queries.size(), static_cast<size_t>(HEIGHT_SAMPLE));
+	seconds = bestOfRepeats(options.repeat, [] {}, [&] {
+		for (size_t i = 0; i < heightSamples; i++) {
+			checksum += static_cast<unsigned long long>(tree.getHeight(queries[i]));
+		}
+	});
+	addResult("getHeight", static_cast<long long>(heightSamples), seconds);
+
+	// copy constructor, the copies are deleted outside of the timing
+	BinTree* copiedTree = nullptr;
+	seconds = bestOfRepeats(options.repeat, [&] { delete copiedTree; copiedTree = nullptr; },
+		[&] { copiedTree = new BinTree(tree); });
+	addResult("copy", size, seconds);
+
+	// operator==, comparing the tree with an equal copy visits every node of both
+	seconds = bestOfRepeats(options.repeat, [] {}, [&] { checksum += (tree == *copiedTree) ? 1 : 0; });
+	addResult("operator==", size, seconds);
+	delete copiedTree;
+
+	// makeEmpty, each run empties a fresh copy
+	BinTree emptiedTree;
+	seconds = bestOfRepeats(options.repeat, [&] { emptiedTree = tree; }, [&] { emptiedTree.makeEmpty(); });
+	addResult("makeEmpty", size, seconds);
+
+	// bstreeToArray and arrayToBSTree, on a tree of the first ARRAYSIZE keys
+	vector<string> arrayKeys(keys.begin(), keys.begin() + min(keys.size(), static_cast<size_t>(ARRAYSIZE)));
+	BinTree arrayTree;
+	NodeData* nodeDataArray[ARRAYSIZE];
+	seconds = bestOfRepeats(options.repeat, [&] {
+		arrayTree.makeEmpty();
+		buildTree(arrayTree, arrayKeys);
+		fill(nodeDataArray, nodeDataArray + ARRAYSIZE, nullptr);
+	}, [&] {
+		arrayTree.bstreeToArray(nodeDataArray);
+		arrayTree.arrayToBSTree(nodeDataArray);
+	});
+	addResult("bstreeToArray+arrayToBSTree", static_cast<long long>(arrayKeys.size()), seconds);
+
+	// ArtTree insert and retrieve, the same keys and lookups as the BinTree above
+	ArtTree artTree;
+	seconds = bestOfRepeats(options.repeat, [&] { artTree.makeEmpty(); }, [&] { buildTree(artTree, keys); });
+	addResult("art insert", size, seconds);
+	seconds = bestOfRepeats(options.repeat, [] {}, [&] {
+		NodeData* retrievedNodeData;
+		for (const NodeData& query : queries) {
+			checksum += artTree.retrieve(query, retrievedNodeData) ? 1 : 0;
+		}
+	});
+	addResult("art retrieve", static_cast<long long>(queries.size()), seconds);
+	artTree.makeEmpty();
+
+	// PagedBinTree insert, each run starts from a new file, with a cache big enough for every
+	// page (a page holds at least a few keys, so one page per 8 keys is more than enough)
+	size_t wholeTreeCache = static_cast<size_t>(size) / 8 + PAGED_SMALL_CACHE;
+	PagedBinTree pagedTree;
+	bool pagedOk = true;
+	seconds = bestOfRepeats(options.repeat, [&] { pagedOk = pagedTree.create(options.pagedFile, wholeTreeCache) && pagedOk; }, [&] {
+		for (const string& key : keys) {
+			pagedTree.insert(NodeData(key));
+		}
+	});
+	addResult("paged insert", size, seconds);
+
+	// PagedBinTree retrieve, first with every page already in the cache and then from a
+	// small cache, which is reopened so that it starts cold
+	seconds = bestOfRepeats(options.repeat, [] {}, [&] {
+		for (const NodeData& query : queries) {
+			checksum += pagedTree.retrieve(query) ? 1 : 0;
+		}
+	});
+	addResult("paged retrieve (warm)", static_cast<long long>(queries.size()), seconds);
+
+	pagedOk = pagedTree.close() && pagedOk;
+	seconds = bestOfRepeats(options.repeat, [&] { pagedOk = pagedTree.open(options.pagedFile, PAGED_SMALL_CACHE) && pagedOk; }, [&] {
+		for (const NodeData& query : queries) {
+			checksum += pagedTree.retrieve(query) ? 1 : 0;
+		}
+	});
+	addResult("paged retrieve (" + to_string(PAGED_SMALL_CACHE) + " page cache)", static_cast<long long>(queries.size()), seconds);
+
+	pagedOk = !pagedTree.hasError() && pagedTree.close() && pagedOk;
+	remove(options.pagedFile.c_str());
+	if (!pagedOk) {
+		cerr << "the paged tree could not use " << options.pagedFile << endl;
+	}
+
+	if (checksum == 0) {
+		cerr << "no lookups succeeded" << endl;
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[printCsv]----------------------------------------------
+// Description: The printCsv global method prints the results as CSV with a header row.
+// -------------------------------------------------------------------------------------------
+void printCsv(const vector<BenchResult>& results) {
+	cout << "distribution,size,operation,operations,seconds,ns_per_op" << endl;
+	for (const BenchResult& result : results) {
+		cout << result.distribution << ',' << result.size << ',' << result.operation << ','
+			<< result.operations << ',' << result.seconds << ','
+			<< (result.operations > 0 ? result.seconds * 1e9 / result.operations : 0) << endl;
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[printJson]---------------------------------------------
+// Description: The printJson global method prints the results as one JSON object, with the
+// settings of the run (and the compiler, when it says) next to the list of results.
+// -------------------------------------------------------------------------------------------
+void printJson(const vector<BenchResult>& results, const BenchOptions& options) {
+	cout << "{" << endl;
+	cout << "  \"benchmark\": \"bintree\"," << endl;
+#ifdef __VERSION__
+	cout << "  \"compiler\": \"" << __VERSION__ << "\"," << endl;
+#endif
+	cout << "  \"seed\": " << options.seed << "," << endl;
+	cout << "  \"repeat\": " << options.repeat << "," << endl;
+	cout << "  \"results\": [" << endl;
+	for (size_t i = 0; i < results.size(); i++) {
+		const BenchResult& result = results[i];
+		cout << "    {\"distribution\": \"" << result.distribution << "\", \"size\": " << result.size
+			<< ", \"operation\": \"" << result.operation << "\", \"operations\": " << result.operations
+			<< ", \"seconds\": " << result.seconds << ", \"ns_per_op\": "
+			<< (result.operations > 0 ? result.seconds * 1e9 / result.operations : 0) << "}"
+			<< (i + 1 < results.size() ? "," : "") << endl;
+	}
+	cout << "  ]" << endl;
+	cout << "}" << endl;
+}
+// -------------------------------------------------------------------------------------------
@@ -2,7 +2,7 @@
 // David Schurer
 // CSS 343
 // Creation Date: 4/12/2023
-// Date of Last Modification: 4/20/2023
+// Date of Last Modification: 10/19/2026
 // ---------------------------------------------------------------------
 // Purpose - The bintree.cpp is the implemenation file for the binary search
 // tree class that implements all of the public and private methods of the
@@ -21,18 +21,43 @@
 // traverse the right subtree of the binary search tree.
 // ---------------------------------------------------------------------
 #include "bintree.h"
+#include "prefetch.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <iostream>
+#include <new>
+#include <future>
 #include <queue>
+#include <system_error>
+#include <thread>
 using namespace std;
 
+// Counter hooks for the hot paths, they expand to nothing unless BINTREE_STATS is
+// defined, so that an uninstrumented build does no extra work at all
+#ifdef BINTREE_STATS
+#define STATS_ADD(field, amount) (counters.field += (amount))
+#define STATS_DEPTH(depth) recordDescentDepth(depth)
+#define STATS_RESET() resetStats()
+#else
+#define STATS_ADD(field, amount) ((void)0)
+#define STATS_DEPTH(depth) ((void)(depth))
+#define STATS_RESET() ((void)0)
+#endif
+
 // -----------------------------[Default Constructor]-----------------------------------------
 // Description: The default constructor for the BinTree class initializies an empty
 // binary search tree by setting the root of the tree to nullptr.
 // -------------------------------------------------------------------------------------------
 BinTree::BinTree()
 {
-	// Initialize the root to nullptr
+	// Initialize the root to nullptr, duplicates are rejected until counting mode is turned on
 	root = nullptr;
+	countingMode = false;
+	countedNodes = false;
+	setOperationNodes = 0;
+	rebalancedSize = 0;
+	STATS_RESET();
 }
 // -------------------------------------------------------------------------------------------
 
@@ -43,11 +68,70 @@ BinTree::BinTree()
 // -------------------------------------------------------------------------------------------
 BinTree::BinTree(const BinTree &otherBinTree)
 {
-	// Initialize the root of the new tree to nullptr
+	// Initialize the root of the new tree to nullptr, the copy counts duplicates if the original does
 	root = nullptr;
+	countingMode = otherBinTree.countingMode;
+	countedNodes = otherBinTree.countedNodes;
+	setOperationNodes = otherBinTree.setOperationNodes;
+	rebalancedSize = otherBinTree.rebalancedSize;
+	STATS_RESET();
 
 	// Call the copy constructor helper method to copy the nodes of otherBinTree
-	copyConstructorHelper(root, otherBinTree.root);
+	copyConstructorHelper(root, otherBinTree.root, otherBinTree);
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------[Move Constructor]-------------------------------------------
+// Description: The move constructor for the BinTree class takes over the nodes of
+// otherBinTree without copying them, leaving otherBinTree empty.
+// -------------------------------------------------------------------------------------------
+BinTree::BinTree(BinTree &&otherBinTree) noexcept
+{
+	root = nullptr;
+	countingMode = false;
+	countedNodes = false;
+	setOperationNodes = 0;
+	rebalancedSize = 0;
+	STATS_RESET();
+	swap(otherBinTree);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[Move Assignment]-------------------------------------------
+// Description: The move assignment operator for the BinTree class deletes the nodes of this
+// binary search tree and takes over the nodes of otherBinTree, leaving otherBinTree empty.
+// -------------------------------------------------------------------------------------------
+BinTree& BinTree::operator=(BinTree &&otherBinTree) noexcept
+{
+	if (this != &otherBinTree)
+	{
+		makeEmpty();
+		swap(otherBinTree);
+	}
+	return *this;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[swap]------------------------------------------------
+// Description: The swap method exchanges the contents of this binary search tree and
+// otherBinTree by exchanging their roots and modes (and their counters when they are
+// compiled in).
+// -------------------------------------------------------------------------------------------
+void BinTree::swap(BinTree &otherBinTree) noexcept
+{
+	std::swap(root, otherBinTree.root);
+	std::swap(countingMode, otherBinTree.countingMode);
+	std::swap(countedNodes, otherBinTree.countedNodes);
+	std::swap(setOperationNodes, otherBinTree.setOperationNodes);
+	std::swap(rebalancedSize, otherBinTree.rebalancedSize);
+#ifdef BINTREE_STATS
+	std::swap(counters, otherBinTree.counters);
+#endif
+}
+
+void swap(BinTree &firstBinTree, BinTree &secondBinTree) noexcept
+{
+	firstBinTree.swap(secondBinTree);
 }
 // -------------------------------------------------------------------------------------------
 
@@ -57,7 +141,7 @@ BinTree::BinTree(const BinTree &otherBinTree)
 // the data from the nodes of the other binary search tree into the new binary search tree.
 // The new binary search tree that is created is a deep copy of the other binary search tree.
 // -------------------------------------------------------------------------------------------
-void BinTree::copyConstructorHelper(Node* &newBinTreeNode, Node* otherBinTreeNode) const
+void BinTree::copyConstructorHelper(Node* &newBinTreeNode, Node* otherBinTreeNode, const BinTree &otherBinTree)
 {
 	// If the other binary tree node is a nullptr, set the new binary tree node to nullptr
 	if (otherBinTreeNode == nullptr)
@@ -68,13 +152,16 @@ void BinTree::copyConstructorHelper(Node* &newBinTreeNode, Node* otherBinTreeNod
 	if (otherBinTreeNode != nullptr)
 	{
 		// Create a new node and copy the data from the other binary tree node into the new binary tree node data
-		newBinTreeNode = new Node();
-		newBinTreeNode->data = new NodeData(*otherBinTreeNode->data);
+		newBinTreeNode = newHeapNode(new NodeData(*otherBinTreeNode->data), countedNodes);
+		setCountOf(newBinTreeNode, otherBinTree.countOf(otherBinTreeNode));
+		STATS_ADD(nodesVisited, 1);
+		STATS_ADD(allocations, 2);
+		STATS_ADD(bytesAllocated, nodeBytes() + sizeof(NodeData));
 
 		// Recursively copy the nodes from the left subtree and right subtree of the other
 		// binary tree into the new binary tree
-		copyConstructorHelper(newBinTreeNode->left, otherBinTreeNode->left);
-		copyConstructorHelper(newBinTreeNode->right, otherBinTreeNode->right);
+		copyConstructorHelper(newBinTreeNode->left, otherBinTreeNode->left, otherBinTree);
+		copyConstructorHelper(newBinTreeNode->right, otherBinTreeNode->right, otherBinTree);
 	}
 }
 // -------------------------------------------------------------------------------------------
@@ -96,13 +183,15 @@ BinTree::~BinTree()
 // by removing all of the nodes from the binary search tree and deallocating the memory
 // that was used by the nodes in the binary search tree, this method does this by calling
 // the emptyBinTreeHelper method, which will use a postorder traversal to delete all of the
-// nodes in the binary search tree.
+// nodes in the binary search tree. An empty tree goes back to plain Nodes unless it is in
+// counting mode.
 // -------------------------------------------------------------------------------------------
 void BinTree::makeEmpty()
 {
 	// Call the empty binary tree helper method to delete all of the nodes in the tree
 	emptyBinTreeHelper(root);
 	root = nullptr;
+	countedNodes = countingMode;
 }
 // -------------------------------------------------------------------------------------------
 
@@ -127,8 +216,7 @@ void BinTree::emptyBinTreeHelper(Node* &node)
 		emptyBinTreeHelper(node->right);
 
 		// Deallocates the node data, then the node itself, then sets the node to nullptr
-		delete node->data;
-		delete node;
+		destroyNode(node);
 		node = nullptr;
 	}
 }
@@ -170,6 +258,8 @@ int BinTree::getHeightHelper(const NodeData& nodeData, Node* currentNode) const
 	 {
 		return 0;
 	 }
+	 STATS_ADD(nodesVisited, 1);
+	 STATS_ADD(comparisons, 1);
 	 
 	 // If the current node's data is equal to the nodeData we are looking for, call the 
 	 // getHeight recursive helper method to find the height of that nodeData
@@ -210,17 +300,21 @@ int BinTree::getHeightRecursiveHelper(Node* currentNode) const
     {
         return 0;
     }
+	STATS_ADD(nodesVisited, 1);
 
 	// Recursively calculates the height of currentNode in the binary search tree by
 	// comparing the heights of its left subtree and its right subtree and returning the highest
-	// height of the two subtrees + 1 to account for the currentNode itself
-	if (getHeightRecursiveHelper(currentNode->left) > getHeightRecursiveHelper(currentNode->right))
+	// height of the two subtrees + 1 to account for the currentNode itself, each subtree's
+	// height is only calculated once so the whole subtree is visited once
+	int leftSubTreeHeight = getHeightRecursiveHelper(currentNode->left);
+	int rightSubTreeHeight = getHeightRecursiveHelper(currentNode->right);
+	if (leftSubTreeHeight > rightSubTreeHeight)
 	{
-		return getHeightRecursiveHelper(currentNode->left) + 1;
+		return leftSubTreeHeight + 1;
 	}
 	else
 	{
-		return getHeightRecursiveHelper(currentNode->right) + 1;
+		return rightSubTreeHeight + 1;
 	}
 }
 // -------------------------------------------------------------------------------------------
@@ -268,16 +362,13 @@ void BinTree::bstreeToArrayRecursiveHelper(Node* currentNode, NodeData* nodeData
 		bstreeToArrayRecursiveHelper(currentNode->left, nodeDataArray, arrayIndex);
 
 		// At the given index of the array, the binary search tree's node data is added into the 
-		// array, then that node's data of the binary search tree is set to nullptr and we increment the index of the array
-		nodeDataArray[arrayIndex] = currentNode->data;
-		currentNode->data = nullptr;
+		// array, the node is deleted (after saving its right child), and we increment the index of the array
+		Node* rightNode = currentNode->right;
+		nodeDataArray[arrayIndex] = detachNodeData(currentNode);
 		arrayIndex++;
 
 		// Helper method recursively calls itself to traverse the right subtree of the binary search tree
-		bstreeToArrayRecursiveHelper(currentNode->right, nodeDataArray, arrayIndex);
-		
-		// After we have added the node from the binary search tree to the array, delete that node from the binary search tree
-		delete currentNode;
+		bstreeToArrayRecursiveHelper(rightNode, nodeDataArray, arrayIndex);
 	}
 }
 // -------------------------------------------------------------------------------------------
@@ -370,7 +461,11 @@ BinTree& BinTree::operator=(const BinTree &otherBinTree)
 	else
 	{
 		makeEmpty();
-		copyConstructorHelper(root, otherBinTree.root);
+		countingMode = otherBinTree.countingMode;
+		countedNodes = otherBinTree.countedNodes;
+		setOperationNodes = otherBinTree.setOperationNodes;
+		rebalancedSize = otherBinTree.rebalancedSize;
+		copyConstructorHelper(root, otherBinTree.root, otherBinTree);
 	}
 
 	// Return the current binary search tree object
@@ -411,6 +506,8 @@ bool BinTree::equalityOperatorHelper(Node* currentNode, Node* otherNode) const
 	{
 		return true;
 	}
+	STATS_ADD(nodesVisited, 2);
+	STATS_ADD(comparisons, 1);
 
 	// If the data in the node of the current binary search tree is not equal to the
 	// data of the node of the other binary search tree, they are not equal
@@ -482,6 +579,8 @@ bool BinTree::inequalityOperatorHelper(Node* currentNode, Node* otherNode) const
 	{
 		return false;
 	}
+	STATS_ADD(nodesVisited, 2);
+	STATS_ADD(comparisons, 1);
 
 	// If the data in the current tree's node is not equal to the data in the other tree's node,
 	// then the trees are not equal
@@ -540,83 +639,326 @@ ostream& operator<<(ostream& out, const BinTree &binTree)
 
 // ------------------------------------[insert]-----------------------------------------------
 // Description: The insert method for the BinTree class inserts a node into the
-// binary search tree with a given node data. It traverses the binary search tree
-// and compares the data of each node to the new node data that is being passed in.
+// binary search tree with a given node data. It first searches the binary search tree
+// for the new node data, and only allocates the new node once it has found the empty
+// child pointer the node belongs at, so a duplicate allocates nothing. It returns true
+// when the new node data was linked into the tree, and false for a duplicate, in which
+// case the caller still owns newNodeData (in counting mode, the duplicate is counted).
 // -------------------------------------------------------------------------------------------
 bool BinTree::insert(NodeData* newNodeData)
 {
-	// A new node is created with its data set to the passed in node data
-	Node* newNode = new Node;
-	newNode->data = newNodeData;
-
-	// The new node's left and right pointers are initialized to nullptr
-	newNode->left = nullptr;
-	newNode->right = nullptr;
+	// link is the child pointer that holds the new node data's key, or the empty one it belongs in
+	Node** link = findLinkByKey(newNodeData->getData());
 
-	// If the binary search tree is empty, the new node is set as the root
-	// of the tree
-	if (root == nullptr)
+	// If the key is already in the tree, return false as duplicates are not allowed
+	if (*link != nullptr)
 	{
-		root = newNode;
-		return true;
+		recordDuplicate(*link);
+		return false;
 	}
 
-	// If the tree is not empty, we will traverse the tree by using currentNode
-	// and starting from the root of the tree
-	Node* currentNode = root;
-	Node* parentNode = nullptr;
+	// Return true as the new node was successfully inserted into the binary search tree
+	linkNewNode(link, newNodeData);
+	return true;
+}
+// -------------------------------------------------------------------------------------------
 
-	while (currentNode != nullptr)
+// --------------------------------[findLinkByKey]--------------------------------------------
+// Description: The findLinkByKey method walks down the binary search tree looking for key,
+// with one three-way comparison per node. It returns the address of the child pointer (or
+// root) that points at the node holding key, or if key is not in the tree, the address of
+// the empty child pointer where a node for key would be linked in.
+// -------------------------------------------------------------------------------------------
+BinTree::Node** BinTree::findLinkByKey(string_view key)
+{
+	Node** link = &root;
+
+	while (*link != nullptr)
 	{
-		// If the new node's data is smaller than the current node's data, traverse left
-		if (*newNodeData < *currentNode->data)
-		{
-			parentNode = currentNode;
-			currentNode = currentNode->left;
-		}
+		STATS_ADD(nodesVisited, 1);
+		STATS_ADD(comparisons, 1);
 
-		// If the new node's data is equal to the current node's data, delete the new
-		// node and return false as duplicates are not allowed
-		else if (*newNodeData == *currentNode->data)
+		// A positive comparison means the node's data is larger, so the key is to the left
+		int comparison = (*link)->data->compare(key);
+		if (comparison == 0)
 		{
-			delete newNode;
-			newNode = nullptr;
-			return false;
+			break;
 		}
+		link = (comparison > 0) ? &(*link)->left : &(*link)->right;
+	}
+	return link;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[recordDuplicate]-------------------------------------------
+// Description: The recordDuplicate method is called when insert or emplace find their key
+// already in existingNode, in counting mode it adds one to the node's count, otherwise the
+// duplicate is simply rejected. A tree in counting mode is made of CountedNodes, so the count
+// is in the node itself and counting allocates nothing.
+// -------------------------------------------------------------------------------------------
+void BinTree::recordDuplicate(Node* existingNode)
+{
+	if (countingMode)
+	{
+		static_cast<CountedNode*>(existingNode)->count++;
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[linkNewNode]---------------------------------------------
+// Description: The linkNewNode method allocates a leaf node for newNodeData, which the tree
+// takes ownership of, and links it in at link, the empty child pointer found by findLinkByKey.
+// -------------------------------------------------------------------------------------------
+void BinTree::linkNewNode(Node** link, NodeData* newNodeData)
+{
+	Node* newNode = newHeapNode(newNodeData, countedNodes);
+	STATS_ADD(allocations, 1);
+	STATS_ADD(bytesAllocated, nodeBytes());
+
+	*link = newNode;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[emplaceByKey]--------------------------------------------
+// Description: The emplaceByKey method is the helper method for emplace with a single string
+// argument, it searches for key as it is and only copies it into a new NodeData, and links
+// that in, if key is not in the binary search tree yet.
+// -------------------------------------------------------------------------------------------
+bool BinTree::emplaceByKey(string_view key)
+{
+	Node** link = findLinkByKey(key);
+	if (*link != nullptr)
+	{
+		recordDuplicate(*link);
+		return false;
+	}
+
+	STATS_ADD(allocations, 1);
+	STATS_ADD(bytesAllocated, sizeof(NodeData));
+	linkNewNode(link, new NodeData(string(key)));
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[emplaceNodeData]-------------------------------------------
+// Description: The emplaceNodeData method is the helper method for emplace, it inserts
+// candidateNodeData if its key is not in the binary search tree yet. Only then are the new
+// Node and NodeData allocated, and the string is moved into the NodeData, not copied.
+// -------------------------------------------------------------------------------------------
+bool BinTree::emplaceNodeData(NodeData&& candidateNodeData)
+{
+	Node** link = findLinkByKey(candidateNodeData.getData());
+	if (*link != nullptr)
+	{
+		recordDuplicate(*link);
+		return false;
+	}
+
+	STATS_ADD(allocations, 1);
+	STATS_ADD(bytesAllocated, sizeof(NodeData));
+	linkNewNode(link, new NodeData(std::move(candidateNodeData)));
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[setCountingMode]-------------------------------------------
+// Description: The setCountingMode method turns counting mode on or off. In counting mode,
+// inserting a key that is already in the tree adds one to its count instead of being
+// rejected. The counts already in the tree are kept when the mode changes. Turning counting
+// mode on moves a tree of plain Nodes onto CountedNodes, which takes O(n) time once.
+// -------------------------------------------------------------------------------------------
+void BinTree::setCountingMode(bool enabled)
+{
+	if (enabled)
+	{
+		useCountedNodes();
+	}
+	countingMode = enabled;
+}
+
+bool BinTree::isCountingMode() const
+{
+	return countingMode;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[count]-----------------------------------------------
+// Description: The count method returns how many times targetNodeData was inserted into the
+// binary search tree, which is always 1 for a key in the tree outside of counting mode, and
+// 0 if the key is not in the tree.
+// -------------------------------------------------------------------------------------------
+int BinTree::count(const NodeData &targetNodeData) const
+{
+	return countByKey(targetNodeData.getData());
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[countByKey]---------------------------------------------
+// Description: The countByKey method is the helper method for count, it searches the binary
+// search tree for targetKey and returns the count of its node, or 0 if it is not found.
+// -------------------------------------------------------------------------------------------
+int BinTree::countByKey(string_view targetKey) const
+{
+	Node* currentNode = root;
+	while (currentNode != nullptr)
+	{
+		STATS_ADD(nodesVisited, 1);
+		STATS_ADD(comparisons, 1);
 
-		// If the new node's data is greater than the current node's data, traverse right
-		else if (*newNodeData > *currentNode->data)
+		int comparison = currentNode->data->compare(targetKey);
+		if (comparison == 0)
 		{
-			parentNode = currentNode;
-			currentNode = currentNode->right;
+			return countOf(currentNode);
 		}
+		currentNode = (comparison > 0) ? currentNode->left : currentNode->right;
 	}
-	
-	// If the new node's data is smaller than the parent node's data, set the left
-	// child of the parent node to the new node
-	if (*newNodeData < *parentNode->data)
+	return 0;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[countOf]----------------------------------------------
+// Description: The countOf method returns the count of node, which is stored in the node of
+// a CountedNode tree and always 1 in a plain Node tree. setCountOf stores a count, a plain
+// Node has nowhere to keep one, so there it does nothing. Both only touch node itself, so
+// the parallel set operations can call them from several threads.
+// -------------------------------------------------------------------------------------------
+int BinTree::countOf(const Node* node) const
+{
+	return countedNodes ? static_cast<const CountedNode*>(node)->count : 1;
+}
+
+void BinTree::setCountOf(Node* node, int nodeCount)
+{
+	if (countedNodes)
 	{
-		parentNode->left = newNode;
+		static_cast<CountedNode*>(node)->count = nodeCount;
 	}
+}
+// -------------------------------------------------------------------------------------------
 
-	// If the new node's data is equal to the parent node's data, delete the new node
-	// and return false as duplicates are not allowed
-	else if (*newNodeData == *parentNode->data)
+// ---------------------------------[useCountedNodes]-----------------------------------------
+// Description: The useCountedNodes method moves a tree of plain Nodes onto CountedNodes with
+// a count of 1 each, keeping its shape and its NodeData, and does nothing for a tree that
+// already has CountedNodes. countedNodesHelper replaces the nodes of one subtree, with the
+// tree still marked as plain Nodes so that the old nodes are freed as what they are.
+// -------------------------------------------------------------------------------------------
+void BinTree::useCountedNodes()
+{
+	if (countedNodes)
 	{
-		delete newNode;
-		newNode = nullptr;
-		return false;
+		return;
 	}
+	root = countedNodesHelper(root);
+	countedNodes = true;
+}
 
-	// If the new node's data is greater than the parent node's data, set the right child
-	// of the parent node to the new node
-	else if (*newNodeData > *parentNode->data)
+BinTree::Node* BinTree::countedNodesHelper(Node* oldNode)
+{
+	if (oldNode == nullptr)
 	{
-		parentNode->right = newNode;
+		return nullptr;
 	}
+	Node* oldLeft = oldNode->left;
+	Node* oldRight = oldNode->right;
+
+	Node* newNode = newHeapNode(detachNodeData(oldNode), true);
+	STATS_ADD(allocations, 1);
+	STATS_ADD(bytesAllocated, sizeof(CountedNode));
+	newNode->left = countedNodesHelper(oldLeft);
+	newNode->right = countedNodesHelper(oldRight);
+	return newNode;
+}
+// -------------------------------------------------------------------------------------------
 
-	// Return true as the new node was successfully inserted into the binary search tree
-	return true;
+// --------------------------------[matchNodeLayout]------------------------------------------
+// Description: The matchNodeLayout method is called before the nodes of otherBinTree are
+// merged into this tree, when one of the two has CountedNodes and the other plain Nodes it
+// moves the plain one onto CountedNodes, so that every node of the result is the same kind.
+// That takes time linear in the size of the plain tree, and only happens the first time two
+// such trees meet, two trees of the same kind are merged as they are.
+// -------------------------------------------------------------------------------------------
+void BinTree::matchNodeLayout(BinTree &otherBinTree)
+{
+	if (countedNodes != otherBinTree.countedNodes)
+	{
+		useCountedNodes();
+		otherBinTree.useCountedNodes();
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[adoptNodes]---------------------------------------------
+// Description: The adoptNodes method makes nodes the contents of this tree, which must be
+// empty, nodesCounted telling whether they are CountedNodes. A tree in counting mode that is
+// handed plain Nodes moves them onto CountedNodes.
+// -------------------------------------------------------------------------------------------
+void BinTree::adoptNodes(Node* nodes, bool nodesCounted)
+{
+	root = nodes;
+	countedNodes = nodesCounted;
+	if (countingMode)
+	{
+		useCountedNodes();
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// Orders the entries of topK, an entry comes first when it has the larger count, or the same
+// count and the smaller key. A heap ordered by it keeps the entry that ranks last on top.
+static bool ranksBefore(const pair<NodeData*, int>& firstEntry, const pair<NodeData*, int>& secondEntry)
+{
+	if (firstEntry.second != secondEntry.second)
+	{
+		return firstEntry.second > secondEntry.second;
+	}
+	return *firstEntry.first < *secondEntry.first;
+}
+
+// -------------------------------------[topK]------------------------------------------------
+// Description: The topK method returns the k keys of the binary search tree with the largest
+// counts, paired with their counts, most frequent first and equal counts in key order. It
+// visits every node once while keeping the best k entries seen so far in a heap with the
+// worst of them on top, so it takes O(n log k) time and O(k) extra space. The node data
+// returned still belongs to the tree.
+// -------------------------------------------------------------------------------------------
+vector<pair<NodeData*, int>> BinTree::topK(int k) const
+{
+	vector<pair<NodeData*, int>> frequentHeap;
+	if (k <= 0)
+	{
+		return frequentHeap;
+	}
+
+	topKHelper(root, static_cast<size_t>(k), frequentHeap);
+	sort_heap(frequentHeap.begin(), frequentHeap.end(), ranksBefore);
+	return frequentHeap;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[topKHelper]---------------------------------------------
+// Description: The topKHelper method is the helper method for topK, it adds the node data of
+// every node in the subtree at currentNode to frequentHeap, dropping the worst entry whenever
+// the heap grows past k entries.
+// -------------------------------------------------------------------------------------------
+void BinTree::topKHelper(Node* currentNode, size_t k, vector<pair<NodeData*, int>>& frequentHeap) const
+{
+	if (currentNode == nullptr)
+	{
+		return;
+	}
+	STATS_ADD(nodesVisited, 1);
+
+	topKHelper(currentNode->left, k, frequentHeap);
+
+	frequentHeap.emplace_back(currentNode->data, countOf(currentNode));
+	push_heap(frequentHeap.begin(), frequentHeap.end(), ranksBefore);
+	if (frequentHeap.size() > k)
+	{
+		pop_heap(frequentHeap.begin(), frequentHeap.end(), ranksBefore);
+		frequentHeap.pop_back();
+	}
+
+	topKHelper(currentNode->right, k, frequentHeap);
 }
 // -------------------------------------------------------------------------------------------
 
@@ -630,12 +972,17 @@ bool BinTree::retrieve(const NodeData& targetNodeData, NodeData* &retrievedNodeD
 {
 	// Create a new node currentNode that will traverse the tree and look for the target node to retrieve
 	Node* currentNode = root;
+	int depth = 0;
 
 	while (currentNode != nullptr)
 	{
+		depth++;
+		STATS_ADD(nodesVisited, 1);
+
 		// If the target node's data is smaller than the current node's data, traverse left
 		if (targetNodeData < *currentNode->data)
 		{
+			STATS_ADD(comparisons, 1);
 			currentNode = currentNode->left;
 		}
 
@@ -643,6 +990,8 @@ bool BinTree::retrieve(const NodeData& targetNodeData, NodeData* &retrievedNodeD
 		// that current node's data and return true
 		else if (*currentNode->data == targetNodeData)
 		{
+			STATS_ADD(comparisons, 2);
+			STATS_DEPTH(depth);
 			retrievedNodeData = currentNode->data;
 			return true;
 		}
@@ -650,9 +999,11 @@ bool BinTree::retrieve(const NodeData& targetNodeData, NodeData* &retrievedNodeD
 		// If the target node's data is greater than the current node's data, traverse right
 		else if (targetNodeData > *currentNode->data)
 		{
+			STATS_ADD(comparisons, 3);
 			currentNode = currentNode->right;
 		}
 	}
+	STATS_DEPTH(depth);
 
 	// Set the retrieved node's data to nullptr and return false if the node was not found in the tree
 	retrievedNodeData = nullptr;
@@ -660,6 +1011,1361 @@ bool BinTree::retrieve(const NodeData& targetNodeData, NodeData* &retrievedNodeD
 }
 // -------------------------------------------------------------------------------------------
 
+// ---------------------------------[retrieveByKey]-------------------------------------------
+// Description: The retrieveByKey method is the helper method for retrieve by a string key,
+// it searches the binary search tree for targetKey with one three-way comparison per node,
+// sets retrievedNodeData to the matching node data (or nullptr) and returns whether it was
+// found.
+// -------------------------------------------------------------------------------------------
+bool BinTree::retrieveByKey(string_view targetKey, NodeData* &retrievedNodeData)
+{
+	Node* currentNode = root;
+	int depth = 0;
+
+	while (currentNode != nullptr)
+	{
+		depth++;
+		STATS_ADD(nodesVisited, 1);
+		STATS_ADD(comparisons, 1);
+
+		// A positive comparison means the node's data is larger, so the key is to the left
+		int comparison = currentNode->data->compare(targetKey);
+		if (comparison == 0)
+		{
+			STATS_DEPTH(depth);
+			retrievedNodeData = currentNode->data;
+			return true;
+		}
+		currentNode = (comparison > 0) ? currentNode->left : currentNode->right;
+	}
+	STATS_DEPTH(depth);
+
+	retrievedNodeData = nullptr;
+	return false;
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[getHeightByKey]-------------------------------------------
+// Description: The getHeightByKey method is the helper method for getHeight by a string key,
+// it finds the node holding targetKey by following the ordering of the tree and returns its
+// height, or 0 if targetKey is not in the tree.
+// -------------------------------------------------------------------------------------------
+int BinTree::getHeightByKey(string_view targetKey) const
+{
+	Node* currentNode = root;
+
+	while (currentNode != nullptr)
+	{
+		STATS_ADD(nodesVisited, 1);
+		STATS_ADD(comparisons, 1);
+
+		int comparison = currentNode->data->compare(targetKey);
+		if (comparison == 0)
+		{
+			return getHeightRecursiveHelper(currentNode);
+		}
+		currentNode = (comparison > 0) ? currentNode->left : currentNode->right;
+	}
+
+	return 0;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[lowerBound]---------------------------------------------
+// Description: The lowerBound method returns the smallest node data in the binary search
+// tree that is not less than targetNodeData, or nullptr if every key is less.
+// -------------------------------------------------------------------------------------------
+NodeData* BinTree::lowerBound(const NodeData &targetNodeData) const
+{
+	return lowerBoundByKey(targetNodeData.getData());
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[lowerBoundByKey]-------------------------------------------
+// Description: The lowerBoundByKey method walks down the binary search tree toward targetKey,
+// remembering the last node it passed on the way left, which is the smallest key seen so far
+// that is not less than targetKey.
+// -------------------------------------------------------------------------------------------
+NodeData* BinTree::lowerBoundByKey(string_view targetKey) const
+{
+	Node* currentNode = root;
+	NodeData* candidate = nullptr;
+
+	while (currentNode != nullptr)
+	{
+		STATS_ADD(nodesVisited, 1);
+		STATS_ADD(comparisons, 1);
+
+		int comparison = currentNode->data->compare(targetKey);
+		if (comparison == 0)
+		{
+			return currentNode->data;
+		}
+
+		// This node is larger than the key, so it is a candidate and anything smaller is to the left
+		if (comparison > 0)
+		{
+			candidate = currentNode->data;
+			currentNode = currentNode->left;
+		}
+		else
+		{
+			currentNode = currentNode->right;
+		}
+	}
+
+	return candidate;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[erase]------------------------------------------------
+// Description: The erase method removes targetNodeData from the binary search tree, deleting
+// its node and node data, and returns false if it was not in the tree.
+// -------------------------------------------------------------------------------------------
+bool BinTree::erase(const NodeData &targetNodeData)
+{
+	return eraseByKey(targetNodeData.getData());
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[eraseByKey]---------------------------------------------
+// Description: The eraseByKey method finds the node holding targetKey and unlinks it. A node
+// with at most one child is replaced by that child. A node with two children is replaced by
+// its inorder successor, the smallest node of its right subtree, which is unlinked from
+// there first. The successor node itself is moved, so every other NodeData stays in the
+// node it was in.
+// -------------------------------------------------------------------------------------------
+bool BinTree::eraseByKey(string_view targetKey)
+{
+	// link is the pointer that points at the node holding targetKey, if there is one
+	Node** link = findLinkByKey(targetKey);
+	Node* targetNode = *link;
+	if (targetNode == nullptr)
+	{
+		return false;
+	}
+
+	if (targetNode->left == nullptr)
+	{
+		*link = targetNode->right;
+	}
+	else if (targetNode->right == nullptr)
+	{
+		*link = targetNode->left;
+	}
+	else
+	{
+		// Unlink the successor, its right subtree takes its place
+		Node** successorLink = &targetNode->right;
+		while ((*successorLink)->left != nullptr)
+		{
+			successorLink = &(*successorLink)->left;
+		}
+		Node* successorNode = *successorLink;
+		*successorLink = successorNode->right;
+
+		// The successor takes over both subtrees of the erased node
+		successorNode->left = targetNode->left;
+		successorNode->right = targetNode->right;
+		*link = successorNode;
+	}
+
+	destroyNode(targetNode);
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[retrieveBatch]--------------------------------------------
+// Description: The retrieveBatch method for the BinTree class searches the binary search tree
+// for each of the count targets in targetNodeData and stores the matching node data (or nullptr)
+// at the same index of retrievedNodeData, it returns the number of targets that were found.
+// The targets are processed in groups of RETRIEVE_BATCH_GROUP_SIZE lookups that descend the
+// tree in lockstep. Each lookup alternates between prefetching the NodeData of the node it has
+// reached and comparing against it, then prefetching the next child, so that while one lookup
+// waits on memory the others in its group are doing useful work.
+// -------------------------------------------------------------------------------------------
+int BinTree::retrieveBatch(const NodeData targetNodeData[], NodeData* retrievedNodeData[], int count)
+{
+	int foundCount = 0;
+
+	// currentNodes holds where each lookup in the group is in the tree, and dataRequested
+	// records whether that node's data has been prefetched yet and is ready to be compared
+	Node* currentNodes[RETRIEVE_BATCH_GROUP_SIZE];
+	bool dataRequested[RETRIEVE_BATCH_GROUP_SIZE];
+	int depths[RETRIEVE_BATCH_GROUP_SIZE];
+
+	for (int groupStart = 0; groupStart < count; groupStart += RETRIEVE_BATCH_GROUP_SIZE)
+	{
+		// The last group may be smaller than a full group
+		int groupSize = count - groupStart;
+		if (groupSize > RETRIEVE_BATCH_GROUP_SIZE)
+		{
+			groupSize = RETRIEVE_BATCH_GROUP_SIZE;
+		}
+
+		// Every lookup in the group starts at the root and is not found until proven otherwise
+		for (int i = 0; i < groupSize; i++)
+		{
+			currentNodes[i] = root;
+			dataRequested[i] = false;
+			depths[i] = 0;
+			retrievedNodeData[groupStart + i] = nullptr;
+		}
+
+		// Keep advancing the group until every lookup has either found its target or fallen off the tree
+		int activeLookups = (root != nullptr) ? groupSize : 0;
+		while (activeLookups > 0)
+		{
+			activeLookups = 0;
+
+			for (int i = 0; i < groupSize; i++)
+			{
+				Node* currentNode = currentNodes[i];
+				if (currentNode == nullptr)
+				{
+					continue;
+				}
+				activeLookups++;
+
+				// The node itself was prefetched on the previous round, so request its data
+				// now and compare against it on the next round
+				if (!dataRequested[i])
+				{
+					PREFETCH_READ(currentNode->data);
+					dataRequested[i] = true;
+					continue;
+				}
+
+				const NodeData& targetData = targetNodeData[groupStart + i];
+				Node* nextNode = nullptr;
+				depths[i]++;
+				STATS_ADD(nodesVisited, 1);
+
+				// If the target is smaller than the current node's data, go left, if it is
+				// greater go right, otherwise the target was found and this lookup is done
+				if (targetData < *currentNode->data)
+				{
+					STATS_ADD(comparisons, 1);
+					nextNode = currentNode->left;
+				}
+				else if (targetData > *currentNode->data)
+				{
+					STATS_ADD(comparisons, 2);
+					nextNode = currentNode->right;
+				}
+				else
+				{
+					STATS_ADD(comparisons, 2);
+					retrievedNodeData[groupStart + i] = currentNode->data;
+					foundCount++;
+				}
+
+				// A lookup that found its target or fell off the tree has finished its descent
+				if (nextNode == nullptr)
+				{
+					STATS_DEPTH(depths[i]);
+				}
+
+				// Start fetching the next node so it has arrived by the time this lookup comes around again
+				if (nextNode != nullptr)
+				{
+					PREFETCH_READ(nextNode);
+				}
+				currentNodes[i] = nextNode;
+				dataRequested[i] = false;
+			}
+		}
+	}
+
+	return foundCount;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[rebalance]---------------------------------------------
+// Description: The rebalance method rebuilds the binary search tree into a balanced shape
+// in place using the Day-Stout-Warren algorithm. Right rotations first straighten the tree
+// into a sorted "vine" hanging off a temporary pseudo-root, then rounds of left rotations
+// along the vine fold it back into a tree whose leaves are all on the bottom two levels.
+// It runs in O(n) time, reuses the existing nodes, and needs no extra memory besides the
+// pseudo-root, unlike the round trip through bstreeToArray and arrayToBSTree.
+// -------------------------------------------------------------------------------------------
+void BinTree::rebalance()
+{
+	rebalancedSize = rebalanceSubtree(root);
+	setOperationNodes = 0;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[rebalanceSubtree]------------------------------------------
+// Description: The rebalanceSubtree method does the work of rebalance for the subtree whose
+// root is held in subtreeRoot (the root of the tree or some node's child pointer), and
+// returns the number of nodes in that subtree.
+// -------------------------------------------------------------------------------------------
+int BinTree::rebalanceSubtree(Node* &subtreeRoot)
+{
+	// The pseudo-root sits above the subtree root so it can be rotated like any other node
+	Node pseudoRoot;
+	pseudoRoot.data = nullptr;
+	pseudoRoot.left = nullptr;
+	pseudoRoot.right = subtreeRoot;
+
+	int nodeCount = treeToVine(&pseudoRoot);
+
+	// fullTreeSize is the largest 2^k - 1 that is at most nodeCount, the nodes beyond it
+	// become the partly filled bottom level, which is made by the first round of rotations
+	int fullTreeSize = 1;
+	while (fullTreeSize <= nodeCount)
+	{
+		fullTreeSize = 2 * fullTreeSize + 1;
+	}
+	fullTreeSize /= 2;
+	compressVine(&pseudoRoot, nodeCount - fullTreeSize);
+
+	// Each following round halves the vine that is left until only the root remains
+	int vineLength = fullTreeSize;
+	while (vineLength > 1)
+	{
+		vineLength /= 2;
+		compressVine(&pseudoRoot, vineLength);
+	}
+
+	subtreeRoot = pseudoRoot.right;
+	return nodeCount;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[treeToVine]---------------------------------------------
+// Description: The treeToVine method is a helper method for rebalance, it rotates every left
+// child up to the right until the tree below pseudoRoot is a vine, a chain of right children
+// in sorted order, and returns the number of nodes in the vine.
+// -------------------------------------------------------------------------------------------
+int BinTree::treeToVine(Node* pseudoRoot)
+{
+	Node* vineTail = pseudoRoot;
+	Node* remainder = vineTail->right;
+	int nodeCount = 0;
+
+	while (remainder != nullptr)
+	{
+		// A node with no left child is already in place, so it joins the vine
+		if (remainder->left == nullptr)
+		{
+			vineTail = remainder;
+			remainder = remainder->right;
+			nodeCount++;
+		}
+
+		// Otherwise rotate its left child up to the right and look at that child next
+		else
+		{
+			Node* leftChild = remainder->left;
+			remainder->left = leftChild->right;
+			leftChild->right = remainder;
+			remainder = leftChild;
+			vineTail->right = leftChild;
+		}
+	}
+
+	return nodeCount;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[compressVine]--------------------------------------------
+// Description: The compressVine method is a helper method for rebalance, it walks down the
+// vine below pseudoRoot and rotates every other node to the left rotationCount times, which
+// moves half of the nodes it passes down into left subtrees.
+// -------------------------------------------------------------------------------------------
+void BinTree::compressVine(Node* pseudoRoot, int rotationCount)
+{
+	Node* scanner = pseudoRoot;
+
+	for (int i = 0; i < rotationCount; i++)
+	{
+		// Rotate the scanner's right child to the left under its own right child
+		Node* child = scanner->right;
+		scanner->right = child->right;
+		scanner = scanner->right;
+		child->right = scanner->left;
+		scanner->left = child;
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[shapeStats]---------------------------------------------
+// Description: The shapeStats method returns the number of nodes, the height, the smallest
+// possible height, the average depth and the root's balance factor of the binary search
+// tree. Comparing height to optimalHeight shows when it is worth calling rebalance. The
+// subtrees are measured with a level order traversal instead of recursion, so that a
+// degenerate tree of any depth can be measured.
+// -------------------------------------------------------------------------------------------
+ShapeStats BinTree::shapeStats() const
+{
+	ShapeStats shape = ShapeStats();
+	if (root == nullptr)
+	{
+		return shape;
+	}
+
+	// Measure the two subtrees of the root separately so their heights give the balance factor
+	int leftCount, leftHeight, rightCount, rightHeight;
+	long long leftDepthSum, rightDepthSum;
+	shapeStatsHelper(root->left, leftCount, leftHeight, leftDepthSum);
+	shapeStatsHelper(root->right, rightCount, rightHeight, rightDepthSum);
+
+	shape.nodeCount = leftCount + rightCount + 1;
+	shape.height = (leftHeight > rightHeight ? leftHeight : rightHeight) + 1;
+	shape.balanceFactor = leftHeight - rightHeight;
+
+	// Every node in a subtree of the root is one level deeper than it is inside the subtree
+	long long depthSum = 1 + leftDepthSum + leftCount + rightDepthSum + rightCount;
+	shape.averageDepth = static_cast<double>(depthSum) / shape.nodeCount;
+
+	// A tree with height h holds at most 2^h - 1 nodes
+	while ((1LL << shape.optimalHeight) - 1 < shape.nodeCount)
+	{
+		shape.optimalHeight++;
+	}
+
+	return shape;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[shapeStatsHelper]------------------------------------------
+// Description: The shapeStatsHelper method is the helper method for shapeStats, it visits the
+// subtree at subtreeRoot in level order and sets its node count, its height, and the sum of
+// the depths of its nodes with subtreeRoot at depth 1.
+// -------------------------------------------------------------------------------------------
+void BinTree::shapeStatsHelper(Node* subtreeRoot, int& nodeCount, int& height, long long& depthSum) const
+{
+	nodeCount = 0;
+	height = 0;
+	depthSum = 0;
+	if (subtreeRoot == nullptr)
+	{
+		return;
+	}
+
+	// Each queue entry pairs a node with its depth
+	queue<pair<Node*, int> > levelOrder;
+	levelOrder.push(make_pair(subtreeRoot, 1));
+
+	while (!levelOrder.empty())
+	{
+		Node* currentNode = levelOrder.front().first;
+		int depth = levelOrder.front().second;
+		levelOrder.pop();
+
+		nodeCount++;
+		depthSum += depth;
+		if (depth > height)
+		{
+			height = depth;
+		}
+
+		if (currentNode->left != nullptr)
+		{
+			levelOrder.push(make_pair(currentNode->left, depth + 1));
+		}
+		if (currentNode->right != nullptr)
+		{
+			levelOrder.push(make_pair(currentNode->right, depth + 1));
+		}
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[unionWith]---------------------------------------------
+// Description: The unionWith method makes this binary search tree the union of itself and
+// otherBinTree. The nodes of otherBinTree are moved into this tree rather than copied, the
+// duplicates of keys already in this tree are deleted, and otherBinTree is left empty. In
+// counting mode the count of a key in both trees is the sum of its two counts. Splitting
+// and joining keep the order but not the balance, so the result is rebalanced once enough
+// nodes have been merged in since the last time (see rebalanceAfterSetOperation).
+// -------------------------------------------------------------------------------------------
+void BinTree::unionWith(BinTree &otherBinTree)
+{
+	// The union of a tree with itself is the tree
+	if (this == &otherBinTree)
+	{
+		return;
+	}
+
+	// The other tree's nodes become this tree's, so both trees need the same kind of node,
+	// and since a count lives in its node the halves can still be merged in parallel
+	int mergedNodes = countNodesUpTo(otherBinTree.root, INT_MAX);
+	matchNodeLayout(otherBinTree);
+	root = unionHelper(root, otherBinTree.root, parallelSpawnDepth());
+	otherBinTree.root = nullptr;
+	rebalanceAfterSetOperation(mergedNodes);
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[intersect]---------------------------------------------
+// Description: The intersect method keeps only the keys of this binary search tree that are
+// also in otherBinTree. Every other node of both trees is deleted and otherBinTree is left
+// empty. A key that is kept gets the smaller of its two counts. Like unionWith, the result
+// is rebalanced once enough nodes have been merged in.
+// -------------------------------------------------------------------------------------------
+void BinTree::intersect(BinTree &otherBinTree)
+{
+	// The intersection of a tree with itself is the tree
+	if (this == &otherBinTree)
+	{
+		return;
+	}
+
+	// As in unionWith, the other tree's nodes have to be the same kind as this tree's
+	int mergedNodes = countNodesUpTo(otherBinTree.root, INT_MAX);
+	matchNodeLayout(otherBinTree);
+	root = intersectHelper(root, otherBinTree.root, parallelSpawnDepth());
+	otherBinTree.root = nullptr;
+	rebalanceAfterSetOperation(mergedNodes);
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[difference]---------------------------------------------
+// Description: The difference method removes every key of otherBinTree from this binary
+// search tree, whatever its count. The nodes of otherBinTree are deleted along the way and
+// otherBinTree is left empty. Like unionWith, the result is rebalanced once enough nodes
+// have been merged in.
+// -------------------------------------------------------------------------------------------
+void BinTree::difference(BinTree &otherBinTree)
+{
+	// Removing a tree from itself leaves nothing
+	if (this == &otherBinTree)
+	{
+		makeEmpty();
+		return;
+	}
+
+	// The other tree's nodes are deleted here, so they have to be the same kind as this tree's
+	int mergedNodes = countNodesUpTo(otherBinTree.root, INT_MAX);
+	matchNodeLayout(otherBinTree);
+	root = differenceHelper(root, otherBinTree.root, parallelSpawnDepth());
+	otherBinTree.root = nullptr;
+	rebalanceAfterSetOperation(mergedNodes);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[split]-----------------------------------------------
+// Description: The split method cuts the binary search tree at key, moving the keys smaller
+// than key into lessTree and the keys greater than or equal to key into greaterTree. The
+// previous contents of lessTree and greaterTree are deleted and this tree is left empty
+// (unless it is one of the two). No node is copied, only the nodes on the search path for
+// key are relinked and each count stays in its node, so it takes O(height) time, which is
+// O(log n) on a balanced tree. A result tree in counting mode that gets plain Nodes moves
+// them onto CountedNodes (see adoptNodes), which takes linear time.
+// -------------------------------------------------------------------------------------------
+void BinTree::split(const NodeData &key, BinTree &lessTree, BinTree &greaterTree)
+{
+	// Take the nodes out of this tree first, in case it is also one of the result trees
+	Node* subtree = root;
+	bool nodesCounted = countedNodes;
+	root = nullptr;
+
+	Node* lessNodes;
+	Node* greaterNodes;
+	Node* keyNode = splitHelper(subtree, key, lessNodes, greaterNodes);
+
+	// The node equal to key is the smallest of the greater keys, so it becomes the root of
+	// the greater side with the rest of that side as its right subtree
+	if (keyNode != nullptr)
+	{
+		keyNode->right = greaterNodes;
+		greaterNodes = keyNode;
+	}
+
+	if (&lessTree != this)
+	{
+		lessTree.makeEmpty();
+	}
+	if (&greaterTree != this && &greaterTree != &lessTree)
+	{
+		greaterTree.makeEmpty();
+	}
+
+	// If both results are the same tree, it simply gets all of the keys back
+	if (&lessTree == &greaterTree)
+	{
+		lessTree.adoptNodes(joinHelper(lessNodes, greaterNodes), nodesCounted);
+		return;
+	}
+	lessTree.adoptNodes(lessNodes, nodesCounted);
+	greaterTree.adoptNodes(greaterNodes, nodesCounted);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[join]------------------------------------------------
+// Description: The join method replaces the contents of the binary search tree with the keys
+// of lessTree and greaterTree, which must not overlap, every key of lessTree has to be
+// smaller than every key of greaterTree. The nodes are moved rather than copied and both
+// trees are left empty. If the key ranges overlap, nothing is changed and false is
+// returned. Checking the ranges and joining each take O(height) time, the counts stay in
+// their nodes. Only when one tree has CountedNodes and the other plain Nodes, or the result
+// is in counting mode and gets plain Nodes, are the plain ones first moved onto
+// CountedNodes, in linear time (see matchNodeLayout).
+// -------------------------------------------------------------------------------------------
+bool BinTree::join(BinTree &lessTree, BinTree &greaterTree)
+{
+	Node* lessNodes = lessTree.root;
+	Node* greaterNodes = greaterTree.root;
+
+	// The largest key of lessTree must be smaller than the smallest key of greaterTree
+	if (lessNodes != nullptr && greaterNodes != nullptr)
+	{
+		Node* largestLess = lessNodes;
+		while (largestLess->right != nullptr)
+		{
+			largestLess = largestLess->right;
+		}
+
+		Node* smallestGreater = greaterNodes;
+		while (smallestGreater->left != nullptr)
+		{
+			smallestGreater = smallestGreater->left;
+		}
+
+		if (!(*largestLess->data < *smallestGreater->data))
+		{
+			return false;
+		}
+	}
+
+	// Take the nodes out of both trees, of the same kind, before emptying this one, in case
+	// it is one of them
+	lessTree.matchNodeLayout(greaterTree);
+	lessNodes = lessTree.root;
+	greaterNodes = greaterTree.root;
+	bool nodesCounted = lessTree.countedNodes;
+	lessTree.root = nullptr;
+	greaterTree.root = nullptr;
+	makeEmpty();
+
+	adoptNodes(joinHelper(lessNodes, greaterNodes), nodesCounted);
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[unionHelper]--------------------------------------------
+// Description: The unionHelper method returns the union of the subtrees currentTree and
+// otherTree. The root of currentTree stays the root, otherTree is split around its key, and
+// the two halves are merged into the left and right subtrees. While spawnDepth is above 0
+// and the left subproblem is large, it runs on another thread while this thread does the
+// right one, the two never touch the same nodes.
+// -------------------------------------------------------------------------------------------
+BinTree::Node* BinTree::unionHelper(Node* currentTree, Node* otherTree, int spawnDepth)
+{
+	if (currentTree == nullptr)
+	{
+		return otherTree;
+	}
+	if (otherTree == nullptr)
+	{
+		return currentTree;
+	}
+
+	// Split the other tree around the root key, its copy of that key (if any) is not needed
+	// beyond its count
+	Node* otherLess;
+	Node* otherGreater;
+	Node* duplicateNode = splitHelper(otherTree, *currentTree->data, otherLess, otherGreater);
+	if (duplicateNode != nullptr)
+	{
+		if (countingMode)
+		{
+			setCountOf(currentTree, countOf(currentTree) + countOf(duplicateNode));
+		}
+		destroyNode(duplicateNode);
+	}
+
+	Node* currentLess = currentTree->left;
+	Node* currentGreater = currentTree->right;
+
+	if (spawnDepth > 0 &&
+		countNodesUpTo(currentLess, PARALLEL_SET_OPERATION_CUTOFF) + countNodesUpTo(otherLess, PARALLEL_SET_OPERATION_CUTOFF) >= PARALLEL_SET_OPERATION_CUTOFF)
+	{
+		future<Node*> leftResult = spawnHelper(&BinTree::unionHelper, currentLess, otherLess, spawnDepth - 1);
+		currentTree->right = unionHelper(currentGreater, otherGreater, spawnDepth - 1);
+		currentTree->left = leftResult.valid() ? leftResult.get() : unionHelper(currentLess, otherLess, 0);
+	}
+	else
+	{
+		currentTree->left = unionHelper(currentLess, otherLess, spawnDepth - 1);
+		currentTree->right = unionHelper(currentGreater, otherGreater, spawnDepth - 1);
+	}
+
+	return currentTree;
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[intersectHelper]------------------------------------------
+// Description: The intersectHelper method returns the intersection of the subtrees
+// currentTree and otherTree, deleting every node that is not kept. The root of currentTree
+// is kept only if otherTree held the same key, otherwise the two intersected halves are
+// joined without it.
+// -------------------------------------------------------------------------------------------
+BinTree::Node* BinTree::intersectHelper(Node* currentTree, Node* otherTree, int spawnDepth)
+{
+	// Nothing in one tree can match an empty tree, so the rest of the other tree is deleted
+	if (currentTree == nullptr || otherTree == nullptr)
+	{
+		emptyBinTreeHelper(currentTree);
+		emptyBinTreeHelper(otherTree);
+		return nullptr;
+	}
+
+	Node* otherLess;
+	Node* otherGreater;
+	Node* duplicateNode = splitHelper(otherTree, *currentTree->data, otherLess, otherGreater);
+
+	Node* currentLess = currentTree->left;
+	Node* currentGreater = currentTree->right;
+	Node* lessResult;
+	Node* greaterResult;
+
+	if (spawnDepth > 0 &&
+		countNodesUpTo(currentLess, PARALLEL_SET_OPERATION_CUTOFF) + countNodesUpTo(otherLess, PARALLEL_SET_OPERATION_CUTOFF) >= PARALLEL_SET_OPERATION_CUTOFF)
+	{
+		future<Node*> leftResult = spawnHelper(&BinTree::intersectHelper, currentLess, otherLess, spawnDepth - 1);
+		greaterResult = intersectHelper(currentGreater, otherGreater, spawnDepth - 1);
+		lessResult = leftResult.valid() ? leftResult.get() : intersectHelper(currentLess, otherLess, 0);
+	}
+	else
+	{
+		lessResult = intersectHelper(currentLess, otherLess, spawnDepth - 1);
+		greaterResult = intersectHelper(currentGreater, otherGreater, spawnDepth - 1);
+	}
+
+	// The root key is in both trees, keep this tree's node with the smaller of the two counts
+	// and delete the other's
+	if (duplicateNode != nullptr)
+	{
+		if (countOf(duplicateNode) < countOf(currentTree))
+		{
+			setCountOf(currentTree, countOf(duplicateNode));
+		}
+		destroyNode(duplicateNode);
+		currentTree->left = lessResult;
+		currentTree->right = greaterResult;
+		return currentTree;
+	}
+
+	// The root key is only in this tree, so it is dropped
+	destroyNode(currentTree);
+	return joinHelper(lessResult, greaterResult);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[differenceHelper]------------------------------------------
+// Description: The differenceHelper method returns the subtree currentTree with every key of
+// otherTree removed, deleting the removed nodes and all of the nodes of otherTree. Here
+// currentTree is split around the root key of otherTree, and the halves are reduced by the
+// matching subtrees of otherTree and joined back together.
+// -------------------------------------------------------------------------------------------
+BinTree::Node* BinTree::differenceHelper(Node* currentTree, Node* otherTree, int spawnDepth)
+{
+	if (currentTree == nullptr)
+	{
+		emptyBinTreeHelper(otherTree);
+		return nullptr;
+	}
+	if (otherTree == nullptr)
+	{
+		return currentTree;
+	}
+
+	// Split this tree around the other tree's root key and drop this tree's copy of that key
+	Node* currentLess;
+	Node* currentGreater;
+	Node* duplicateNode = splitHelper(currentTree, *otherTree->data, currentLess, currentGreater);
+	if (duplicateNode != nullptr)
+	{
+		destroyNode(duplicateNode);
+	}
+
+	Node* otherLess = otherTree->left;
+	Node* otherGreater = otherTree->right;
+	destroyNode(otherTree);
+
+	Node* lessResult;
+	Node* greaterResult;
+	if (spawnDepth > 0 &&
+		countNodesUpTo(currentLess, PARALLEL_SET_OPERATION_CUTOFF) + countNodesUpTo(otherLess, PARALLEL_SET_OPERATION_CUTOFF) >= PARALLEL_SET_OPERATION_CUTOFF)
+	{
+		future<Node*> leftResult = spawnHelper(&BinTree::differenceHelper, currentLess, otherLess, spawnDepth - 1);
+		greaterResult = differenceHelper(currentGreater, otherGreater, spawnDepth - 1);
+		lessResult = leftResult.valid() ? leftResult.get() : differenceHelper(currentLess, otherLess, 0);
+	}
+	else
+	{
+		lessResult = differenceHelper(currentLess, otherLess, spawnDepth - 1);
+		greaterResult = differenceHelper(currentGreater, otherGreater, spawnDepth - 1);
+	}
+
+	return joinHelper(lessResult, greaterResult);
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[splitHelper]--------------------------------------------
+// Description: The splitHelper method cuts the subtree at subtree into lessTree, holding the
+// keys smaller than key, and greaterTree, holding the keys greater than key. The node equal
+// to key, if there is one, is detached and returned, otherwise nullptr is returned. Only the
+// nodes on the search path for key are relinked, so it takes time proportional to the depth
+// of that path and no node is copied.
+// -------------------------------------------------------------------------------------------
+BinTree::Node* BinTree::splitHelper(Node* subtree, const NodeData& key, Node* &lessTree, Node* &greaterTree)
+{
+	if (subtree == nullptr)
+	{
+		lessTree = nullptr;
+		greaterTree = nullptr;
+		return nullptr;
+	}
+
+	// The key is to the left, so this node and its right subtree belong to the greater tree,
+	// and whatever in the left subtree is greater than the key becomes its new left subtree
+	if (key < *subtree->data)
+	{
+		Node* duplicateNode = splitHelper(subtree->left, key, lessTree, subtree->left);
+		greaterTree = subtree;
+		return duplicateNode;
+	}
+
+	// The key is to the right, so this node and its left subtree belong to the less tree
+	if (key > *subtree->data)
+	{
+		Node* duplicateNode = splitHelper(subtree->right, key, subtree->right, greaterTree);
+		lessTree = subtree;
+		return duplicateNode;
+	}
+
+	// This node holds the key, its subtrees are exactly the two halves
+	lessTree = subtree->left;
+	greaterTree = subtree->right;
+	subtree->left = nullptr;
+	subtree->right = nullptr;
+	return subtree;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[joinHelper]--------------------------------------------
+// Description: The joinHelper method joins lessTree and greaterTree, where every key of
+// lessTree is smaller than every key of greaterTree, into one subtree and returns its root.
+// The largest node of lessTree is unlinked and becomes the new root with the two trees as
+// its subtrees, so the result is at most one level taller than the taller of the two.
+// -------------------------------------------------------------------------------------------
+BinTree::Node* BinTree::joinHelper(Node* lessTree, Node* greaterTree)
+{
+	if (lessTree == nullptr)
+	{
+		return greaterTree;
+	}
+	if (greaterTree == nullptr)
+	{
+		return lessTree;
+	}
+
+	// Find the largest node of lessTree and unlink it, its left subtree takes its place
+	Node* parentNode = nullptr;
+	Node* largestNode = lessTree;
+	while (largestNode->right != nullptr)
+	{
+		parentNode = largestNode;
+		largestNode = largestNode->right;
+	}
+
+	if (parentNode == nullptr)
+	{
+		lessTree = largestNode->left;
+	}
+	else
+	{
+		parentNode->right = largestNode->left;
+	}
+
+	largestNode->left = lessTree;
+	largestNode->right = greaterTree;
+	return largestNode;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[countNodesUpTo]------------------------------------------
+// Description: The countNodesUpTo method returns the number of nodes in the subtree at
+// subtree, but stops counting once it reaches limit, so it never costs more than limit
+// node visits. It is used to decide whether a subproblem is big enough for its own thread.
+// -------------------------------------------------------------------------------------------
+int BinTree::countNodesUpTo(Node* subtree, int limit) const
+{
+	if (subtree == nullptr || limit <= 0)
+	{
+		return 0;
+	}
+
+	int nodeCount = 1;
+	nodeCount += countNodesUpTo(subtree->left, limit - nodeCount);
+	nodeCount += countNodesUpTo(subtree->right, limit - nodeCount);
+	return nodeCount;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------[rebalanceAfterSetOperation]-----------------------------------
+// Description: The rebalanceAfterSetOperation method adds the mergedNodes nodes of the other
+// tree of a set operation to the count of nodes merged in since the last rebalance, and
+// rebalances the tree once that count reaches the size the tree had after that rebalance.
+// Each rebalance is then paid for by about as many merged nodes as it moves, so it adds
+// O(1) amortized time per merged node, while repeated set operations no longer keep
+// deepening the tree until the split/join recursion drifts toward O(n*m). A tree that was
+// never rebalanced has a size of 0, so its first set operation rebalances it. Merging keys
+// that all sort after (or before) the tree grows one long outer path well before that, so
+// the two outer paths are also checked with rebalanceOuterPath.
+// -------------------------------------------------------------------------------------------
+void BinTree::rebalanceAfterSetOperation(int mergedNodes)
+{
+	setOperationNodes = (mergedNodes < INT_MAX - setOperationNodes) ? setOperationNodes + mergedNodes : INT_MAX;
+	if (setOperationNodes >= rebalancedSize)
+	{
+		rebalance();
+		return;
+	}
+	rebalanceOuterPath(true);
+	rebalanceOuterPath(false);
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------[rebalanceOuterPath]-----------------------------------------
+// Description: The rebalanceOuterPath method walks the leftmost (or rightmost) path of the
+// tree, and if it is longer than twice the height of a balanced tree of the tree's size,
+// rebalances only the lowest subtree on that path that is itself that much too tall for
+// its size, the scapegoat tree approach. The walk stops at the length limit, so a tree in
+// good shape costs O(log n), and finding and rebuilding a subtree cost O(size of it).
+// -------------------------------------------------------------------------------------------
+void BinTree::rebalanceOuterPath(bool leftmostPath)
+{
+	// The tree has at most rebalancedSize + setOperationNodes nodes
+	long long sizeBound = static_cast<long long>(rebalancedSize) + setOperationNodes;
+	int depthLimit = 2;
+	for (long long remainingSize = sizeBound; remainingSize > 0; remainingSize /= 2)
+	{
+		depthLimit += 2;
+	}
+
+	// Collect the links of the path until it is known to be too long
+	vector<Node**> pathLinks;
+	Node** link = &root;
+	while (*link != nullptr && static_cast<int>(pathLinks.size()) <= depthLimit)
+	{
+		pathLinks.push_back(link);
+		link = leftmostPath ? &(*link)->left : &(*link)->right;
+	}
+	if (*link == nullptr)
+	{
+		return;
+	}
+	while (*link != nullptr)
+	{
+		pathLinks.push_back(link);
+		link = leftmostPath ? &(*link)->left : &(*link)->right;
+	}
+
+	// Going up from the bottom, track each subtree's size and the path length below it
+	int subtreeSize = 0;
+	for (int pathIndex = static_cast<int>(pathLinks.size()) - 1; pathIndex >= 0; pathIndex--)
+	{
+		Node* pathNode = *pathLinks[pathIndex];
+		subtreeSize += 1 + countNodesUpTo(leftmostPath ? pathNode->right : pathNode->left, INT_MAX);
+
+		int subtreeLimit = 2;
+		for (int remainingSize = subtreeSize; remainingSize > 0; remainingSize /= 2)
+		{
+			subtreeLimit += 2;
+		}
+		if (static_cast<int>(pathLinks.size()) - pathIndex > subtreeLimit)
+		{
+			rebalanceSubtree(*pathLinks[pathIndex]);
+			return;
+		}
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[spawnHelper]--------------------------------------------
+// Description: The spawnHelper method starts setHelper on currentTree and otherTree on a new
+// thread and returns its future. If no thread can be started, async throws system_error,
+// and an empty future is returned instead so the caller runs that subproblem itself and
+// the tree is never left half rebuilt.
+// -------------------------------------------------------------------------------------------
+future<BinTree::Node*> BinTree::spawnHelper(SetHelper setHelper, Node* currentTree, Node* otherTree, int spawnDepth)
+{
+	try
+	{
+		return async(launch::async, setHelper, this, currentTree, otherTree, spawnDepth);
+	}
+	catch (const system_error&)
+	{
+		return future<Node*>();
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[parallelSpawnDepth]----------------------------------------
+// Description: The parallelSpawnDepth method returns how many levels of a set operation may
+// hand their left subproblem to a new thread, enough levels to give every hardware thread
+// some work, and 0 on a single core machine.
+// -------------------------------------------------------------------------------------------
+int BinTree::parallelSpawnDepth() const
+{
+	unsigned threadCount = thread::hardware_concurrency();
+	int spawnDepth = 0;
+	while ((1u << spawnDepth) < threadCount)
+	{
+		spawnDepth++;
+	}
+	return spawnDepth;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[stats]-----------------------------------------------
+// Description: The stats method returns a copy of the operation counters of the binary search
+// tree. The counters are only kept when the program is compiled with BINTREE_STATS defined,
+// otherwise every field of the returned snapshot is 0.
+// -------------------------------------------------------------------------------------------
+BinTreeStats BinTree::stats() const
+{
+#ifdef BINTREE_STATS
+	return counters;
+#else
+	return BinTreeStats();
+#endif
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[resetStats]---------------------------------------------
+// Description: The resetStats method sets all of the operation counters back to 0.
+// -------------------------------------------------------------------------------------------
+void BinTree::resetStats()
+{
+#ifdef BINTREE_STATS
+	counters = BinTreeStats();
+#endif
+}
+// -------------------------------------------------------------------------------------------
+
+#ifdef BINTREE_STATS
+// ------------------------------[recordDescentDepth]-----------------------------------------
+// Description: The recordDescentDepth method adds one retrieve descent that visited depth
+// nodes to the depth histogram, descents that are too deep go into the last bucket. Only
+// lookups are recorded, the descents of insert, emplace and erase are not.
+// -------------------------------------------------------------------------------------------
+void BinTree::recordDescentDepth(int depth) const
+{
+	if (depth >= BinTreeStats::DEPTH_BUCKETS)
+	{
+		depth = BinTreeStats::DEPTH_BUCKETS - 1;
+	}
+	counters.depthHistogram[depth]++;
+}
+// -------------------------------------------------------------------------------------------
+#endif
+
+// ----------------------------------[newHeapNode]--------------------------------------------
+// Description: The newHeapNode method allocates a leaf node for nodeData on its own, a
+// CountedNode with a count of 1 if countedNode is set and a plain Node otherwise, and
+// deleteHeapNode frees one. A node whose node data directly follows it counts as pooled,
+// two separate allocations are not expected to land like that but nothing promises it, so
+// in that case the node is simply allocated again elsewhere.
+// -------------------------------------------------------------------------------------------
+BinTree::Node* BinTree::newHeapNode(NodeData* nodeData, bool countedNode)
+{
+	size_t newNodeBytes = countedNode ? sizeof(CountedNode) : sizeof(Node);
+	Node* newNode = countedNode ? new CountedNode : new Node;
+	if (reinterpret_cast<char*>(newNode) + newNodeBytes == reinterpret_cast<char*>(nodeData))
+	{
+		Node* otherNode = countedNode ? new CountedNode : new Node;
+		deleteHeapNode(newNode, countedNode);
+		newNode = otherNode;
+	}
+	newNode->data = nodeData;
+	newNode->left = nullptr;
+	newNode->right = nullptr;
+	if (countedNode)
+	{
+		static_cast<CountedNode*>(newNode)->count = 1;
+	}
+	return newNode;
+}
+
+void BinTree::deleteHeapNode(Node* node, bool countedNode)
+{
+	if (countedNode)
+	{
+		delete static_cast<CountedNode*>(node);
+	}
+	else
+	{
+		delete node;
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[isPooled]----------------------------------------------
+// Description: The nodeBytes method returns the size of one node of this tree. The isPooled
+// method returns whether node is in a NodeChunk, which is the case exactly when its node
+// data sits right after it, as compact lays out every slot.
+// -------------------------------------------------------------------------------------------
+size_t BinTree::nodeBytes() const
+{
+	return countedNodes ? sizeof(CountedNode) : sizeof(Node);
+}
+
+bool BinTree::isPooled(const Node* node) const
+{
+	return node->data == reinterpret_cast<const NodeData*>(reinterpret_cast<const char*>(node) + nodeBytes());
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[destroyNode]--------------------------------------------
+// Description: The destroyNode method deletes node and its node data. A node that compact
+// placed in a NodeChunk is not deleted on its own, its node data is destroyed in place and
+// its chunk's live count goes down, and the chunk is freed when that was its last node. The
+// count is atomic because the parallel set operations may delete nodes of the same chunk
+// on different threads.
+// -------------------------------------------------------------------------------------------
+void BinTree::destroyNode(Node* node)
+{
+	if (!isPooled(node))
+	{
+		delete node->data;
+		deleteHeapNode(node, countedNodes);
+		return;
+	}
+
+	node->data->~NodeData();
+	NodeChunk* chunk = reinterpret_cast<NodeChunk*>(reinterpret_cast<uintptr_t>(node) & ~static_cast<uintptr_t>(NODE_CHUNK_BYTES - 1));
+	if (chunk->liveCount.fetch_sub(1, memory_order_acq_rel) == 1)
+	{
+		chunk->~NodeChunk();
+		::operator delete(chunk, align_val_t(NODE_CHUNK_BYTES));
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[detachNodeData]-------------------------------------------
+// Description: The detachNodeData method deletes node and returns its node data as a heap
+// allocated NodeData that the caller owns, which is the node data itself for an ordinary
+// node and a new NodeData that the key is moved into for a node in a NodeChunk.
+// -------------------------------------------------------------------------------------------
+NodeData* BinTree::detachNodeData(Node* node)
+{
+	NodeData* ownedNodeData;
+	if (isPooled(node))
+	{
+		ownedNodeData = new NodeData(std::move(*node->data));
+		destroyNode(node);
+	}
+	else
+	{
+		ownedNodeData = node->data;
+		deleteHeapNode(node, countedNodes);
+	}
+	return ownedNodeData;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[compact]----------------------------------------------
+// Description: The compact method re-lays-out the tree in fresh memory. It copies every node
+// in preorder into consecutive slots of new NodeChunks, each node followed directly by its
+// NodeData, so a parent is usually on the same cache line or page as its left child and a
+// descent moves forward through memory. A key short enough for the string's inline buffer
+// sits inside its slot, a longer key is copied into a new buffer, so those buffers are also
+// allocated in preorder. The old nodes are deleted as soon as they are copied, and chunks
+// from an earlier compact are freed when their last node goes. The tree can be used
+// normally afterwards, new nodes are allocated one at a time again until the next compact.
+// It returns the locality of the layout before and after.
+// -------------------------------------------------------------------------------------------
+CompactionStats BinTree::compact()
+{
+	CompactionStats compactionStats;
+	compactionStats.before = localityStats();
+	compactionStats.chunksAllocated = 0;
+
+	NodeChunk* currentChunk = nullptr;
+	int nextSlot = SLOTS_PER_CHUNK;
+	root = compactHelper(root, currentChunk, nextSlot, compactionStats.chunksAllocated);
+
+	compactionStats.after = localityStats();
+	return compactionStats;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[compactHelper]-------------------------------------------
+// Description: The compactHelper method is the recursive helper method for compact, it
+// copies oldNode into the next free slot, starting a new chunk when the current one is
+// full, then copies the left and right subtrees after it, deletes oldNode, and returns the
+// copy.
+// -------------------------------------------------------------------------------------------
+BinTree::Node* BinTree::compactHelper(Node* oldNode, NodeChunk* &currentChunk, int &nextSlot, int &chunksAllocated)
+{
+	if (oldNode == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (nextSlot == SLOTS_PER_CHUNK)
+	{
+		currentChunk = new (::operator new(NODE_CHUNK_BYTES, align_val_t(NODE_CHUNK_BYTES))) NodeChunk();
+		currentChunk->liveCount.store(0, memory_order_relaxed);
+		nextSlot = 0;
+		chunksAllocated++;
+		STATS_ADD(allocations, 1);
+		STATS_ADD(bytesAllocated, NODE_CHUNK_BYTES);
+	}
+	STATS_ADD(nodesVisited, 1);
+
+	// Slot 0 of the chunk is its header, the node goes at the start of its slot and the node data right after
+	char* slotAddress = reinterpret_cast<char*>(currentChunk) + (nextSlot + 1) * NODE_SLOT_BYTES;
+	nextSlot++;
+	currentChunk->liveCount.fetch_add(1, memory_order_relaxed);
+
+	Node* newNode = countedNodes ? new (slotAddress) CountedNode : new (slotAddress) Node;
+	newNode->data = new (slotAddress + nodeBytes()) NodeData(*oldNode->data);
+	setCountOf(newNode, countOf(oldNode));
+
+	newNode->left = compactHelper(oldNode->left, currentChunk, nextSlot, chunksAllocated);
+	newNode->right = compactHelper(oldNode->right, currentChunk, nextSlot, chunksAllocated);
+	destroyNode(oldNode);
+	return newNode;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[localityStats]-------------------------------------------
+// Description: The localityStats method measures how the tree is laid out in memory, the
+// average distance in bytes from a node to its children and to its node data, and how many
+// parent to child links stay within one 4 KB page. Smaller distances and more links within
+// a page mean fewer cache and TLB misses per descent.
+// -------------------------------------------------------------------------------------------
+LocalityStats BinTree::localityStats() const
+{
+	LocalityStats layoutStats;
+	layoutStats.nodeCount = 0;
+	double childDistanceSum = 0;
+	long long samePageLinks = 0;
+	double dataDistanceSum = 0;
+	localityHelper(root, layoutStats.nodeCount, childDistanceSum, samePageLinks, dataDistanceSum);
+
+	// A tree of n nodes has n - 1 parent to child links
+	int linkCount = layoutStats.nodeCount - 1;
+	layoutStats.averageChildDistance = (linkCount > 0) ? childDistanceSum / linkCount : 0;
+	layoutStats.samePageFraction = (linkCount > 0) ? static_cast<double>(samePageLinks) / linkCount : 0;
+	layoutStats.averageDataDistance = (layoutStats.nodeCount > 0) ? dataDistanceSum / layoutStats.nodeCount : 0;
+	return layoutStats;
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[localityHelper]-------------------------------------------
+// Description: The localityHelper method is the recursive helper method for localityStats,
+// it adds the node and link measurements of the subtree at currentNode to the sums.
+// -------------------------------------------------------------------------------------------
+void BinTree::localityHelper(Node* currentNode, int &nodeCount, double &childDistanceSum, long long &samePageLinks, double &dataDistanceSum) const
+{
+	if (currentNode == nullptr)
+	{
+		return;
+	}
+	nodeCount++;
+
+	const int PAGE_SHIFT = 12;
+	uintptr_t nodeAddress = reinterpret_cast<uintptr_t>(currentNode);
+	uintptr_t dataAddress = reinterpret_cast<uintptr_t>(currentNode->data);
+	dataDistanceSum += static_cast<double>((dataAddress > nodeAddress) ? dataAddress - nodeAddress : nodeAddress - dataAddress);
+
+	Node* children[2] = { currentNode->left, currentNode->right };
+	for (Node* childNode : children)
+	{
+		if (childNode == nullptr)
+		{
+			continue;
+		}
+		uintptr_t childAddress = reinterpret_cast<uintptr_t>(childNode);
+		childDistanceSum += static_cast<double>((childAddress > nodeAddress) ? childAddress - nodeAddress : nodeAddress - childAddress);
+		if ((childAddress >> PAGE_SHIFT) == (nodeAddress >> PAGE_SHIFT))
+		{
+			samePageLinks++;
+		}
+		localityHelper(childNode, nodeCount, childDistanceSum, samePageLinks, dataDistanceSum);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[freeze]----------------------------------------------
+// Description: The freeze method for the BinTree class compiles the binary search tree into
+// a FrozenBinTree, an immutable snapshot that keeps the keys in one contiguous array in
+// Eytzinger order. The snapshot holds its own copies of the keys, so the binary search
+// tree is left unchanged and can be modified or destroyed afterwards.
+// -------------------------------------------------------------------------------------------
+FrozenBinTree BinTree::freeze() const
+{
+	// Collect copies of the node data in sorted order with an inorder traversal
+	vector<NodeData> sortedNodeData;
+	freezeHelper(root, sortedNodeData);
+
+	return FrozenBinTree(std::move(sortedNodeData));
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[freezeHelper]--------------------------------------------
+// Description: The freezeHelper method is the recursive helper method for the freeze method,
+// it traverses the binary search tree inorder and appends a copy of each node's data to
+// sortedNodeData.
+// -------------------------------------------------------------------------------------------
+void BinTree::freezeHelper(Node* currentNode, vector<NodeData>& sortedNodeData) const
+{
+	if (currentNode != nullptr)
+	{
+		freezeHelper(currentNode->left, sortedNodeData);
+		sortedNodeData.push_back(*currentNode->data);
+		freezeHelper(currentNode->right, sortedNodeData);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[InorderCursor]--------------------------------------------
+// Description: The InorderCursor constructor starts the cursor at the smallest key of
+// binTree by pushing the path of left children from the root. Each advance pops a node and
+// pushes the left path of its right subtree, so a full walk touches every node twice and
+// the stack never holds more than the height of the tree.
+// -------------------------------------------------------------------------------------------
+BinTree::InorderCursor::InorderCursor(const BinTree &binTree)
+{
+	pushLeftPath(binTree.root);
+}
+
+void BinTree::InorderCursor::pushLeftPath(Node* currentNode)
+{
+	while (currentNode != nullptr)
+	{
+		pendingNodes.push_back(currentNode);
+		currentNode = currentNode->left;
+	}
+}
+
+bool BinTree::InorderCursor::isDone() const
+{
+	return pendingNodes.empty();
+}
+
+NodeData* BinTree::InorderCursor::current() const
+{
+	return pendingNodes.back()->data;
+}
+
+void BinTree::InorderCursor::advance()
+{
+	Node* visitedNode = pendingNodes.back();
+	pendingNodes.pop_back();
+	pushLeftPath(visitedNode->right);
+}
+// -------------------------------------------------------------------------------------------
+
 // --------------------------------[displaySideways]------------------------------------------
 // Description: The displaySideways method displays the binary search tree
 // from its side by calling the sideways method.
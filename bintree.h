@@ -2,7 +2,7 @@
 // David Schurer
 // CSS 343
 // Creation Date: 4/12/2023
-// Date of Last Modification: 4/20/2023
+// Date of Last Modification: 10/19/2026
 // ---------------------------------------------------------------------
 // Purpose - The bintree.h file is the header file for the BinTree class,
 // it contains all of the method declarations for the binary search tree
@@ -12,14 +12,85 @@
 // Notes - The BinTree class uses many helper methods to help implement the
 // various different class methods such as makeEmpty, getHeight, bstreeToArray,
 // arrayToBSTree, and the overloaded equality and inequality operators of
-// the binary search tree class.
+// the binary search tree class. The retrieveBatch method looks up many
+// targets at once, advancing a group of lookups in lockstep and prefetching
+// the next node of each lookup so the cache misses overlap. The freeze
+// method compiles the tree into an immutable FrozenBinTree for read-mostly use.
+// When compiled with -DBINTREE_STATS, each tree counts the comparisons, node
+// visits, lookup depths and allocations of its operations (see stats()),
+// without that flag the counters are compiled out entirely. The rebalance
+// method reshapes the tree in place with the Day-Stout-Warren algorithm, and
+// shapeStats reports how far the tree has drifted from a balanced shape.
+// The set operations unionWith, intersect and difference merge two trees by
+// splitting and joining subtrees, moving nodes instead of copying them, and
+// rebalance the result once as many nodes have been merged in as it held at
+// its last rebalance.
+// The same two primitives are available directly as split and join.
+// Trees can be moved and swapped without copying any nodes, and emplace
+// builds a new key inside the tree only when it is not already there.
+// retrieve, getHeight, lowerBound and erase also accept a plain string key
+// (string_view, const char* or string), which is compared in place.
+// insert and emplace search for the key before allocating anything, so a
+// duplicate costs no allocation. In counting mode (see setCountingMode) a
+// duplicate bumps the occurrence count of the node already holding the key,
+// and count and topK report those counts. An InorderCursor walks the keys in
+// sorted order one at a time, so several trees can be merged key by key.
+// The compact method moves every node, with its NodeData, into large chunks
+// in preorder, so that a descent reads memory in mostly increasing order
+// instead of jumping around the heap, and localityStats measures the result.
 // ---------------------------------------------------------------------
 #ifndef BIN_TREE_H
 #define BIN_TREE_H
 #include "nodedata.h"
+#include "frozentree.h"
+#include "stringkey.h"
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <iostream>
 using namespace std;
 
+// The BinTreeStats struct is a snapshot of the counters of one BinTree, every
+// field stays 0 unless the program is compiled with BINTREE_STATS defined
+struct BinTreeStats {
+    // Descents deeper than the last bucket are counted in the last bucket
+    static const int DEPTH_BUCKETS = 64;
+
+    unsigned long long comparisons;                     // NodeData comparisons
+    unsigned long long nodesVisited;                    // nodes read by searches, traversals and copies
+    unsigned long long allocations;                     // Node and NodeData objects allocated
+    unsigned long long bytesAllocated;                  // bytes requested by those allocations
+    unsigned long long depthHistogram[DEPTH_BUCKETS];   // retrieve lookups by nodes visited
+};
+
+// The ShapeStats struct describes the shape of a BinTree as reported by shapeStats
+struct ShapeStats {
+    int nodeCount;          // number of nodes in the tree
+    int height;             // nodes on the longest root to leaf path, 0 for an empty tree
+    int optimalHeight;      // smallest height any tree with nodeCount nodes can have
+    double averageDepth;    // average nodes visited to reach a node, counting the root as 1
+    int balanceFactor;      // height of the root's left subtree minus its right subtree
+};
+
+// The LocalityStats struct describes how the nodes of a BinTree are laid out in memory
+struct LocalityStats {
+    int nodeCount;                  // number of nodes in the tree
+    double averageChildDistance;    // average bytes between a node and each of its children
+    double samePageFraction;        // fraction of parent to child links within one 4 KB page
+    double averageDataDistance;     // average bytes between a node and its NodeData
+};
+
+// The CompactionStats struct is the report of one BinTree::compact call
+struct CompactionStats {
+    LocalityStats before;           // layout of the tree before it was compacted
+    LocalityStats after;            // layout of the tree after it was compacted
+    int chunksAllocated;            // node chunks the compacted tree was laid out in
+};
+
 class BinTree {
 
     private:
@@ -32,20 +103,162 @@ class BinTree {
             Node* right;                               
         };
 
+        // The CountedNode struct is the node of a tree that counts duplicates, a Node followed
+        // by the number of times its key was inserted. Only a tree that has been in counting
+        // mode pays the extra bytes, every other tree is made of plain Nodes
+        struct CountedNode : Node {
+            int count;
+        };
+
+        // The NodeChunk struct is the header of one block of nodes made by compact, the block
+        // is NODE_CHUNK_BYTES long and aligned to its length, so the header of a pooled node is
+        // found by rounding its address down. The header takes the first slot, and each other
+        // slot holds a Node followed directly by its NodeData, which is how a pooled node is
+        // told apart (see isPooled). liveCount is the number of slots still in use, the block
+        // is freed when it reaches 0. A slot is big enough for either kind of node.
+        struct NodeChunk {
+            atomic<int> liveCount;
+        };
+
+        // Sizes of a chunk and of one slot in it, a slot is a whole number of cache lines
+        static const size_t NODE_CHUNK_BYTES = 64 * 1024;
+        static const size_t NODE_SLOT_BYTES = (sizeof(CountedNode) + sizeof(NodeData) + 63) / 64 * 64;
+        static const int SLOTS_PER_CHUNK = static_cast<int>(NODE_CHUNK_BYTES / NODE_SLOT_BYTES) - 1;
+
         // Pointer to the root node of the binary search tree
         Node* root;                                   
 
+        // Whether inserting a duplicate key counts it instead of rejecting it
+        bool countingMode;
+
+        // Whether every node of the tree is a CountedNode, which is always the case in counting
+        // mode, in a plain Node tree every key has a count of 1
+        bool countedNodes;
+
+        // Nodes merged in by set operations since the tree was last rebalanced, and the number
+        // of nodes it had then
+        int setOperationNodes;
+        int rebalancedSize;
+
+        // Number of lookups that retrieveBatch advances in lockstep
+        static const int RETRIEVE_BATCH_GROUP_SIZE = 16;
+
+        // Set operations only hand a subproblem to another thread when it has at least this many nodes
+        static const int PARALLEL_SET_OPERATION_CUTOFF = 4096;
+
+#ifdef BINTREE_STATS
+        // Operation counters, mutable so that const methods can count too
+        mutable BinTreeStats counters;
+
+    // Helper method that adds one descent of the given depth to the depth histogram
+    void recordDescentDepth(int depth) const;
+#endif
+
     // Helper methods for inorder traversal, displaySideways, and the copy constructor
     void inorderHelper(Node* binTreeNode) const;
     void sideways(Node* current, int level) const;                  
-    void copyConstructorHelper(Node* &newBinTreeNode, Node* otherBinTreeNode) const;
+    void copyConstructorHelper(Node* &newBinTreeNode, Node* otherBinTreeNode, const BinTree &otherBinTree);
+
+    // Helper methods for rebalance and shapeStats
+    int rebalanceSubtree(Node* &subtreeRoot);
+    int treeToVine(Node* pseudoRoot);
+    void compressVine(Node* pseudoRoot, int rotationCount);
+    void shapeStatsHelper(Node* subtreeRoot, int& nodeCount, int& height, long long& depthSum) const;
+
+    // Helper methods for the string key overloads, these compare the key against each NodeData in place
+    bool retrieveByKey(string_view targetKey, NodeData* &retrievedNodeData);
+    int getHeightByKey(string_view targetKey) const;
+    NodeData* lowerBoundByKey(string_view targetKey) const;
+    bool eraseByKey(string_view targetKey);
+
+    // Helper methods for insert and emplace, finding the link that holds a key (or where it
+    // belongs), counting a duplicate, and linking in a new node
+    Node** findLinkByKey(string_view key);
+    void recordDuplicate(Node* existingNode);
+    void linkNewNode(Node** link, NodeData* newNodeData);
+    bool emplaceByKey(string_view key);
+    bool emplaceNodeData(NodeData&& candidateNodeData);
+
+    // Helper methods for count and topK, for reading and setting the count of a node, and for
+    // moving a tree (or a pair of trees about to be merged) onto CountedNodes
+    int countByKey(string_view targetKey) const;
+    int countOf(const Node* node) const;
+    void setCountOf(Node* node, int nodeCount);
+    void useCountedNodes();
+    Node* countedNodesHelper(Node* oldNode);
+    void matchNodeLayout(BinTree &otherBinTree);
+    void adoptNodes(Node* nodes, bool nodesCounted);
+    void topKHelper(Node* currentNode, size_t k, vector<pair<NodeData*, int>>& frequentHeap) const;
+
+    // Helper methods for splitting and joining subtrees, used by the set operations
+    Node* splitHelper(Node* subtree, const NodeData& key, Node* &lessTree, Node* &greaterTree);
+    Node* joinHelper(Node* lessTree, Node* greaterTree);
+    int countNodesUpTo(Node* subtree, int limit) const;
+    int parallelSpawnDepth() const;
+
+    // Recursive helper methods for unionWith, intersect and difference, and the helper that
+    // runs one of them on another thread (an empty future if no thread could be started)
+    typedef Node* (BinTree::*SetHelper)(Node* currentTree, Node* otherTree, int spawnDepth);
+    Node* unionHelper(Node* currentTree, Node* otherTree, int spawnDepth);
+    Node* intersectHelper(Node* currentTree, Node* otherTree, int spawnDepth);
+    Node* differenceHelper(Node* currentTree, Node* otherTree, int spawnDepth);
+    future<Node*> spawnHelper(SetHelper setHelper, Node* currentTree, Node* otherTree, int spawnDepth);
+    void rebalanceAfterSetOperation(int mergedNodes);
+    void rebalanceOuterPath(bool leftmostPath);
+
+    // Helper methods that allocate a Node or CountedNode on the heap for nodeData and free one,
+    // that give the size of this tree's nodes and tell whether a node is in a NodeChunk, that
+    // delete a node and its node data wherever they were allocated, and that delete a node but
+    // hand its node data to the caller as a separate heap object
+    static Node* newHeapNode(NodeData* nodeData, bool countedNode);
+    static void deleteHeapNode(Node* node, bool countedNode);
+    size_t nodeBytes() const;
+    bool isPooled(const Node* node) const;
+    void destroyNode(Node* node);
+    NodeData* detachNodeData(Node* node);
+
+    // Helper methods for compact and localityStats
+    Node* compactHelper(Node* oldNode, NodeChunk* &currentChunk, int &nextSlot, int &chunksAllocated);
+    void localityHelper(Node* currentNode, int &nodeCount, double &childDistanceSum, long long &samePageLinks, double &dataDistanceSum) const;
+
+    // Helper method for freeze that copies the node data into a vector in sorted order
+    void freezeHelper(Node* currentNode, vector<NodeData>& sortedNodeData) const;
 
     public:
+        // The InorderCursor class walks the node data of a tree in sorted order with an explicit
+        // stack, one key per advance, the tree must not change while a cursor is walking it
+        class InorderCursor {
+
+            private:
+                // The nodes whose keys are still to come, the next key is on top
+                vector<Node*> pendingNodes;
+
+            // Helper method that pushes currentNode and its chain of left children
+            void pushLeftPath(Node* currentNode);
+
+            public:
+                // Starts a cursor at the smallest key of binTree
+                explicit InorderCursor(const BinTree &binTree);
+
+                // isDone is true after the last key, current is the key the cursor is at
+                bool isDone() const;
+                NodeData* current() const;
+
+                // Moves the cursor to the next larger key
+                void advance();
+        };
+
         // Binary search tree constructor, copy constructor, and destructor
         BinTree();                                     
         BinTree(const BinTree &otherBinTree);          
         ~BinTree();   
 
+        // Move constructor, move assignment and swap, these hand over the nodes without copying them
+        BinTree(BinTree &&otherBinTree) noexcept;
+        BinTree& operator=(BinTree &&otherBinTree) noexcept;
+        void swap(BinTree &otherBinTree) noexcept;
+        friend void swap(BinTree &firstBinTree, BinTree &secondBinTree) noexcept;
+
         // makeEmpty and its helper method used to delete all of the nodes in the tree                         
         void makeEmpty(); 
         void emptyBinTreeHelper(Node* &node);  
@@ -67,6 +280,69 @@ class BinTree {
         bool insert(NodeData* newNodeData);                        
         bool retrieve(const NodeData &targetNodeData, NodeData* &retrievedNodeData);   
 
+        // Retrieve by a string key, without building a NodeData for it
+        template <class Key, StringKeyOnly<Key> = 0>
+        bool retrieve(const Key &targetKey, NodeData* &retrievedNodeData);
+
+        // Returns the smallest node data that is not less than the target, or nullptr if there is none
+        NodeData* lowerBound(const NodeData &targetNodeData) const;
+        template <class Key, StringKeyOnly<Key> = 0>
+        NodeData* lowerBound(const Key &targetKey) const;
+
+        // Removes the target from the tree and deletes its node data, returns false if it was not there
+        bool erase(const NodeData &targetNodeData);
+        template <class Key, StringKeyOnly<Key> = 0>
+        bool erase(const Key &targetKey);
+
+        // Builds a NodeData from args and inserts it, only allocating if the key is not already in the tree
+        template <class... Args>
+        bool emplace(Args&&... args);
+
+        // Counting mode keeps one node per key and counts how many times it was inserted,
+        // instead of rejecting the repeats, it is off by default
+        void setCountingMode(bool enabled);
+        bool isCountingMode() const;
+
+        // Returns how many times the key was inserted, 0 if it is not in the tree
+        int count(const NodeData &targetNodeData) const;
+        template <class Key, StringKeyOnly<Key> = 0>
+        int count(const Key &targetKey) const;
+
+        // Returns the (at most) k keys with the largest counts and their counts, most frequent
+        // first and equal counts in key order
+        vector<pair<NodeData*, int>> topK(int k) const;
+
+        // Batched retrieve, looks up count targets and returns how many were found
+        int retrieveBatch(const NodeData targetNodeData[], NodeData* retrievedNodeData[], int count);
+
+        // Set operations, the result is left in this tree and otherBinTree is left empty
+        void unionWith(BinTree &otherBinTree);
+        void intersect(BinTree &otherBinTree);
+        void difference(BinTree &otherBinTree);
+
+        // Moves the keys smaller than key into lessTree and the rest into greaterTree, leaving this tree empty
+        void split(const NodeData &key, BinTree &lessTree, BinTree &greaterTree);
+
+        // Replaces this tree with the keys of lessTree and greaterTree, which are left empty,
+        // returns false and changes nothing if some key of lessTree is not smaller than all of greaterTree
+        bool join(BinTree &lessTree, BinTree &greaterTree);
+
+        // Rebuilds the tree into a balanced shape in place, and reports the current shape
+        void rebalance();
+        ShapeStats shapeStats() const;
+
+        // stats returns a snapshot of the operation counters, resetStats sets them back to 0
+        BinTreeStats stats() const;
+        void resetStats();
+
+        // Moves every node and its node data into contiguous chunks in preorder, and reports
+        // the layout before and after
+        CompactionStats compact();
+        LocalityStats localityStats() const;
+
+        // Compiles the tree into an immutable, read-optimized snapshot
+        FrozenBinTree freeze() const;
+
         // Method to display the tree sideways
         void displaySideways() const;                
         
@@ -74,6 +350,10 @@ class BinTree {
         int getHeight (const NodeData &nodeData) const;
         int getHeightHelper(const NodeData& nodeData, Node* currentNode) const;
         int getHeightRecursiveHelper(Node* currentNode) const;
+
+        // getHeight by a string key, without building a NodeData for it
+        template <class Key, StringKeyOnly<Key> = 0>
+        int getHeight(const Key &targetKey) const;
     
         // Methods to convert the binary search tree into an array
         // and to convert an array into a binary search tree
@@ -85,4 +365,64 @@ class BinTree {
         void arrayToBStreeRecursiveHelper(Node* currentNode, NodeData* nodeDataArray[], int lowIndex, int highIndex);
 };
 
+// ------------------------------------[emplace]----------------------------------------------
+// Description: The emplace method builds the NodeData for a new key from args (the same
+// arguments a NodeData constructor takes) and inserts it, returning false if the key is
+// already in the tree (in counting mode, the key's count goes up instead). A single string
+// argument is looked up as it is, and only copied into a new NodeData if the key is missing.
+// Other arguments build the key on the stack first, and it is only moved into a heap
+// allocated NodeData once the tree has found there is a place for it. Either way a duplicate
+// never allocates a Node, a NodeData or a string.
+// -------------------------------------------------------------------------------------------
+template <class... Args>
+bool BinTree::emplace(Args&&... args)
+{
+    if constexpr (sizeof...(Args) == 1 && (is_convertible<const Args&, string_view>::value && ...))
+    {
+        return emplaceByKey(string_view(args...));
+    }
+    else
+    {
+        return emplaceNodeData(NodeData(std::forward<Args>(args)...));
+    }
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------[string key lookups]-----------------------------------------
+// Description: These overloads of retrieve, getHeight, lowerBound, erase and count take the target
+// as any string key type (string_view, const char*, string, ...) and compare it with the
+// node data in place through a string_view, so no NodeData or string is allocated to look
+// a key up. They behave exactly like the NodeData versions.
+// -------------------------------------------------------------------------------------------
+template <class Key, StringKeyOnly<Key>>
+bool BinTree::retrieve(const Key &targetKey, NodeData* &retrievedNodeData)
+{
+    return retrieveByKey(string_view(targetKey), retrievedNodeData);
+}
+
+template <class Key, StringKeyOnly<Key>>
+int BinTree::getHeight(const Key &targetKey) const
+{
+    return getHeightByKey(string_view(targetKey));
+}
+
+template <class Key, StringKeyOnly<Key>>
+NodeData* BinTree::lowerBound(const Key &targetKey) const
+{
+    return lowerBoundByKey(string_view(targetKey));
+}
+
+template <class Key, StringKeyOnly<Key>>
+bool BinTree::erase(const Key &targetKey)
+{
+    return eraseByKey(string_view(targetKey));
+}
+
+template <class Key, StringKeyOnly<Key>>
+int BinTree::count(const Key &targetKey) const
+{
+    return countByKey(string_view(targetKey));
+}
+// -------------------------------------------------------------------------------------------
+
 #endif
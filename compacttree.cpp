@@ -0,0 +1,488 @@
+// -------------------------- compacttree.cpp --------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The compacttree.cpp file is the implementation file for the
+// CompactBinTree class, the pooled binary search tree with 32-bit child
+// indices and packed key bytes.
+// ---------------------------------------------------------------------
+// Notes - Nodes are only ever appended to the pool, so an index stays
+// valid for the life of the tree even when the pool grows and moves. Keys
+// are compared with memcmp over the packed bytes, which orders them the
+// same way as the strings in NodeData.
+// ---------------------------------------------------------------------
+#include "compacttree.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+// Identifies the start of a saved CompactBinTree
+static const char COMPACT_TREE_MAGIC[4] = { 'C', 'B', 'T', '1' };
+
+// Number of bytes read reserves room for at a time
+static const size_t READ_CHUNK_BYTES = 1 << 20;
+
+// ---------------------------------[readInChunks]--------------------------------------------
+// Description: The readInChunks function reads count raw elements from in into buffer, growing
+// buffer one chunk at a time so it never holds much more than was actually read. It returns
+// false if the input ends first.
+// -------------------------------------------------------------------------------------------
+template <class Element>
+static bool readInChunks(istream& in, vector<Element>& buffer, uint64_t count)
+{
+	const uint64_t chunkElements = READ_CHUNK_BYTES / sizeof(Element);
+	buffer.clear();
+	while (buffer.size() < count)
+	{
+		size_t readFrom = buffer.size();
+		size_t readCount = static_cast<size_t>(min(count - readFrom, chunkElements));
+		buffer.resize(readFrom + readCount);
+		in.read(reinterpret_cast<char*>(buffer.data() + readFrom), readCount * sizeof(Element));
+		if (!in)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------[Default Constructor]-----------------------------------------
+// Description: The default constructor for the CompactBinTree class creates an empty tree.
+// -------------------------------------------------------------------------------------------
+CompactBinTree::CompactBinTree()
+{
+	root = NULL_INDEX;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[makeEmpty]-----------------------------------------------
+// Description: The makeEmpty method removes every key from the tree and releases the memory
+// of both buffers.
+// -------------------------------------------------------------------------------------------
+void CompactBinTree::makeEmpty()
+{
+	vector<CompactNode>().swap(nodes);
+	vector<char>().swap(keyBytes);
+	root = NULL_INDEX;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[isEmpty]----------------------------------------------
+// Description: The isEmpty method returns true if the tree holds no keys.
+// -------------------------------------------------------------------------------------------
+bool CompactBinTree::isEmpty() const
+{
+	return root == NULL_INDEX;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[size]------------------------------------------------
+// Description: The size method returns the number of keys in the tree.
+// -------------------------------------------------------------------------------------------
+int CompactBinTree::size() const
+{
+	return static_cast<int>(nodes.size());
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[compareKey]---------------------------------------------
+// Description: The compareKey method compares key with the key of the node at nodeIndex, it
+// returns a negative number, 0, or a positive number when key is smaller, equal, or larger.
+// -------------------------------------------------------------------------------------------
+int CompactBinTree::compareKey(const string& key, uint32_t nodeIndex) const
+{
+	const CompactNode& node = nodes[nodeIndex];
+	size_t sharedLength = key.size() < node.keyLength ? key.size() : node.keyLength;
+
+	int result = (sharedLength == 0) ? 0 : memcmp(key.data(), &keyBytes[node.keyOffset], sharedLength);
+	if (result != 0)
+	{
+		return result;
+	}
+
+	// With equal shared bytes, the shorter key is the smaller one
+	if (key.size() < node.keyLength)
+	{
+		return -1;
+	}
+	return (key.size() > node.keyLength) ? 1 : 0;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[findNode]-----------------------------------------------
+// Description: The findNode method returns the pool index of the node holding key, or
+// NULL_INDEX if key is not in the tree.
+// -------------------------------------------------------------------------------------------
+uint32_t CompactBinTree::findNode(const string& key) const
+{
+	uint32_t currentIndex = root;
+
+	while (currentIndex != NULL_INDEX)
+	{
+		int comparison = compareKey(key, currentIndex);
+		if (comparison == 0)
+		{
+			return currentIndex;
+		}
+		currentIndex = (comparison < 0) ? nodes[currentIndex].left : nodes[currentIndex].right;
+	}
+
+	return NULL_INDEX;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[insert]-----------------------------------------------
+// Description: The insert method adds a copy of the key of newNodeData to the tree. It first
+// walks down to the spot where the key belongs, so a duplicate is rejected before anything is
+// added to the buffers. It returns false for a duplicate, and also if the tree has run out
+// of 32-bit node indices or key buffer offsets.
+// -------------------------------------------------------------------------------------------
+bool CompactBinTree::insert(const NodeData &newNodeData)
+{
+	const string& key = newNodeData.getData();
+
+	// Find the parent the new node hangs from, and which side it goes on
+	uint32_t parentIndex = NULL_INDEX;
+	bool goesLeft = false;
+	uint32_t currentIndex = root;
+	while (currentIndex != NULL_INDEX)
+	{
+		int comparison = compareKey(key, currentIndex);
+		if (comparison == 0)
+		{
+			return false;
+		}
+		parentIndex = currentIndex;
+		goesLeft = comparison < 0;
+		currentIndex = goesLeft ? nodes[currentIndex].left : nodes[currentIndex].right;
+	}
+
+	// The pool index and the key offset both have to fit in 32 bits
+	if (nodes.size() >= NULL_INDEX || keyBytes.size() + key.size() > 0xFFFFFFFFu)
+	{
+		return false;
+	}
+
+	// Append the key bytes and the node, then link the node to its parent
+	CompactNode newNode;
+	newNode.left = NULL_INDEX;
+	newNode.right = NULL_INDEX;
+	newNode.keyOffset = static_cast<uint32_t>(keyBytes.size());
+	newNode.keyLength = static_cast<uint32_t>(key.size());
+	keyBytes.insert(keyBytes.end(), key.begin(), key.end());
+
+	uint32_t newIndex = static_cast<uint32_t>(nodes.size());
+	nodes.push_back(newNode);
+
+	if (parentIndex == NULL_INDEX)
+	{
+		root = newIndex;
+	}
+	else if (goesLeft)
+	{
+		nodes[parentIndex].left = newIndex;
+	}
+	else
+	{
+		nodes[parentIndex].right = newIndex;
+	}
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[retrieve]----------------------------------------------
+// Description: The retrieve method returns true if targetNodeData is in the tree.
+// -------------------------------------------------------------------------------------------
+bool CompactBinTree::retrieve(const NodeData &targetNodeData) const
+{
+	return findNode(targetNodeData.getData()) != NULL_INDEX;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[retrieve]----------------------------------------------
+// Description: This retrieve method returns true if targetNodeData is in the tree and sets
+// retrievedNodeData to a copy of the stored key. The tree holds no NodeData objects to
+// point to, so the key is copied out of the key buffer instead.
+// -------------------------------------------------------------------------------------------
+bool CompactBinTree::retrieve(const NodeData &targetNodeData, NodeData &retrievedNodeData) const
+{
+	uint32_t nodeIndex = findNode(targetNodeData.getData());
+	if (nodeIndex == NULL_INDEX)
+	{
+		return false;
+	}
+
+	const CompactNode& node = nodes[nodeIndex];
+	retrievedNodeData = NodeData(string(keyBytes.data() + node.keyOffset, node.keyLength));
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[getHeight]---------------------------------------------
+// Description: The getHeight method returns the height of the node holding nodeData, 1 for a
+// leaf, or 0 if nodeData is not in the tree.
+// -------------------------------------------------------------------------------------------
+int CompactBinTree::getHeight(const NodeData &nodeData) const
+{
+	uint32_t nodeIndex = findNode(nodeData.getData());
+	return (nodeIndex == NULL_INDEX) ? 0 : getHeightRecursiveHelper(nodeIndex);
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------[getHeightRecursiveHelper]--------------------------------------
+// Description: The getHeightRecursiveHelper method returns the height of the subtree at
+// nodeIndex, the larger height of its two subtrees plus 1 for the node itself.
+// -------------------------------------------------------------------------------------------
+int CompactBinTree::getHeightRecursiveHelper(uint32_t nodeIndex) const
+{
+	if (nodeIndex == NULL_INDEX)
+	{
+		return 0;
+	}
+
+	int leftHeight = getHeightRecursiveHelper(nodes[nodeIndex].left);
+	int rightHeight = getHeightRecursiveHelper(nodes[nodeIndex].right);
+	return (leftHeight > rightHeight ? leftHeight : rightHeight) + 1;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator==]---------------------------------------------
+// Description: The overloaded equality operator returns true if both trees have the same
+// shape and the same key in every node, the same rule BinTree uses.
+// -------------------------------------------------------------------------------------------
+bool CompactBinTree::operator==(const CompactBinTree &otherTree) const
+{
+	return equalityHelper(root, otherTree, otherTree.root);
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator!=]---------------------------------------------
+// Description: The overloaded inequality operator returns true if the trees differ in shape
+// or in any key.
+// -------------------------------------------------------------------------------------------
+bool CompactBinTree::operator!=(const CompactBinTree &otherTree) const
+{
+	return !(*this == otherTree);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[equalityHelper]--------------------------------------------
+// Description: The equalityHelper method recursively compares the subtree at currentIndex of
+// this tree with the subtree at otherIndex of otherTree.
+// -------------------------------------------------------------------------------------------
+bool CompactBinTree::equalityHelper(uint32_t currentIndex, const CompactBinTree& otherTree, uint32_t otherIndex) const
+{
+	if (currentIndex == NULL_INDEX || otherIndex == NULL_INDEX)
+	{
+		return currentIndex == otherIndex;
+	}
+
+	const CompactNode& currentNode = nodes[currentIndex];
+	const CompactNode& otherNode = otherTree.nodes[otherIndex];
+	if (currentNode.keyLength != otherNode.keyLength || (currentNode.keyLength > 0 &&
+		memcmp(keyBytes.data() + currentNode.keyOffset, otherTree.keyBytes.data() + otherNode.keyOffset, currentNode.keyLength) != 0))
+	{
+		return false;
+	}
+
+	return equalityHelper(currentNode.left, otherTree, otherNode.left) &&
+		equalityHelper(currentNode.right, otherTree, otherNode.right);
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator<<]---------------------------------------------
+// Description: The overloaded output operator prints the keys of the tree in sorted order
+// separated by spaces, followed by a newline.
+// -------------------------------------------------------------------------------------------
+ostream& operator<<(ostream& out, const CompactBinTree &compactTree)
+{
+	compactTree.inorderHelper(out, compactTree.root);
+	out << endl;
+	return out;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[inorderHelper]-------------------------------------------
+// Description: The inorderHelper method prints the keys of the subtree at nodeIndex using an
+// inorder traversal.
+// -------------------------------------------------------------------------------------------
+void CompactBinTree::inorderHelper(ostream& out, uint32_t nodeIndex) const
+{
+	if (nodeIndex != NULL_INDEX)
+	{
+		const CompactNode& node = nodes[nodeIndex];
+		inorderHelper(out, node.left);
+		out.write(keyBytes.data() + node.keyOffset, node.keyLength);
+		out << " ";
+		inorderHelper(out, node.right);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[displaySideways]------------------------------------------
+// Description: The displaySideways method displays the tree from its side by calling the
+// sideways method.
+// -------------------------------------------------------------------------------------------
+void CompactBinTree::displaySideways() const
+{
+	sideways(root, 0);
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[sideways]---------------------------------------------
+// Description: The sideways method is the recursive helper method for displaySideways, it
+// prints the right subtree, the node, then the left subtree, indented by depth.
+// -------------------------------------------------------------------------------------------
+void CompactBinTree::sideways(uint32_t nodeIndex, int level) const
+{
+	if (nodeIndex != NULL_INDEX)
+	{
+		level++;
+		const CompactNode& node = nodes[nodeIndex];
+		sideways(node.right, level);
+
+		// 4 Spaces are outputted for each depth level for readability
+		for (int i = level; i >= 0; i--)
+		{
+			cout << "    ";
+		}
+		cout.write(keyBytes.data() + node.keyOffset, node.keyLength);
+		cout << endl;
+
+		sideways(node.left, level);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[write]------------------------------------------------
+// Description: The write method saves the tree to out as a small header (a magic tag, the
+// node count, the key byte count and the root index) followed by the node pool and the key
+// buffer copied as raw bytes. The numbers are written in the machine's own byte order.
+// -------------------------------------------------------------------------------------------
+void CompactBinTree::write(ostream& out) const
+{
+	uint64_t nodeCount = nodes.size();
+	uint64_t keyByteCount = keyBytes.size();
+
+	out.write(COMPACT_TREE_MAGIC, sizeof(COMPACT_TREE_MAGIC));
+	out.write(reinterpret_cast<const char*>(&nodeCount), sizeof(nodeCount));
+	out.write(reinterpret_cast<const char*>(&keyByteCount), sizeof(keyByteCount));
+	out.write(reinterpret_cast<const char*>(&root), sizeof(root));
+	out.write(reinterpret_cast<const char*>(nodes.data()), nodeCount * sizeof(CompactNode));
+	out.write(keyBytes.data(), keyByteCount);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[read]------------------------------------------------
+// Description: The read method replaces the tree with one saved by write. It returns false
+// and leaves the tree empty if the input does not start with a saved tree, ends early, or
+// does not describe a valid tree. The buffers grow as their bytes actually arrive, so a
+// damaged count in the header cannot make it allocate more than the input holds, and the
+// root, child indices and key ranges are checked with isValidTree before the tree is used.
+// -------------------------------------------------------------------------------------------
+bool CompactBinTree::read(istream& in)
+{
+	makeEmpty();
+
+	char magic[sizeof(COMPACT_TREE_MAGIC)];
+	uint64_t nodeCount;
+	uint64_t keyByteCount;
+	uint32_t savedRoot;
+
+	in.read(magic, sizeof(magic));
+	in.read(reinterpret_cast<char*>(&nodeCount), sizeof(nodeCount));
+	in.read(reinterpret_cast<char*>(&keyByteCount), sizeof(keyByteCount));
+	in.read(reinterpret_cast<char*>(&savedRoot), sizeof(savedRoot));
+
+	// Key offsets and lengths are 32 bits, so insert never lets the key buffer get bigger
+	if (!in || memcmp(magic, COMPACT_TREE_MAGIC, sizeof(magic)) != 0 || nodeCount >= NULL_INDEX || keyByteCount > NULL_INDEX)
+	{
+		return false;
+	}
+
+	if (!readInChunks(in, nodes, nodeCount) || !readInChunks(in, keyBytes, keyByteCount))
+	{
+		makeEmpty();
+		return false;
+	}
+
+	root = savedRoot;
+	if (!isValidTree())
+	{
+		makeEmpty();
+		return false;
+	}
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[isValidTree]--------------------------------------------
+// Description: The isValidTree method checks a tree that read has just loaded. Every key
+// range has to lie inside the key buffer and every child index inside the node pool, and
+// walking down from the root has to reach every node exactly once, so no node has two
+// parents and there are no cycles or stray nodes. The walk keeps its own stack, so a
+// degenerate tree of any depth can be checked.
+// -------------------------------------------------------------------------------------------
+bool CompactBinTree::isValidTree() const
+{
+	for (const CompactNode& node : nodes)
+	{
+		if (static_cast<uint64_t>(node.keyOffset) + node.keyLength > keyBytes.size())
+		{
+			return false;
+		}
+		if ((node.left != NULL_INDEX && node.left >= nodes.size()) || (node.right != NULL_INDEX && node.right >= nodes.size()))
+		{
+			return false;
+		}
+	}
+
+	if (root == NULL_INDEX)
+	{
+		return nodes.empty();
+	}
+	if (root >= nodes.size())
+	{
+		return false;
+	}
+
+	vector<bool> visited(nodes.size(), false);
+	vector<uint32_t> pending(1, root);
+	size_t visitedCount = 0;
+	while (!pending.empty())
+	{
+		uint32_t nodeIndex = pending.back();
+		pending.pop_back();
+		if (visited[nodeIndex])
+		{
+			return false;
+		}
+		visited[nodeIndex] = true;
+		visitedCount++;
+
+		if (nodes[nodeIndex].left != NULL_INDEX)
+		{
+			pending.push_back(nodes[nodeIndex].left);
+		}
+		if (nodes[nodeIndex].right != NULL_INDEX)
+		{
+			pending.push_back(nodes[nodeIndex].right);
+		}
+	}
+	return visitedCount == nodes.size();
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[memoryFootprint]-------------------------------------------
+// Description: The memoryFootprint method returns the number of bytes held by the node pool
+// and the key buffer, plus the tree object itself.
+// -------------------------------------------------------------------------------------------
+size_t CompactBinTree::memoryFootprint() const
+{
+	return sizeof(*this) + nodes.capacity() * sizeof(CompactNode) + keyBytes.capacity();
+}
+// -------------------------------------------------------------------------------------------
@@ -0,0 +1,99 @@
+// --------------------------- compacttree.h ---------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The compacttree.h file is the header file for the
+// CompactBinTree class, a compact mode of the binary search tree for very
+// large key sets. It has the same insert, retrieve, getHeight, output and
+// comparison interface as BinTree, but stores its nodes very differently.
+// ---------------------------------------------------------------------
+// Notes - All of the nodes live in one growable pool and refer to their
+// children by 32-bit pool indices instead of pointers, and all of the key
+// strings are packed end to end in one growable byte buffer. A node is 16
+// bytes with no separate NodeData allocation, compared to a 24 byte Node
+// plus a NodeData object plus their allocator overhead for BinTree. Since
+// neither buffer holds a pointer, copying the tree copies two buffers, and
+// write and read save and load the tree as two raw blocks.
+// ---------------------------------------------------------------------
+#ifndef COMPACT_TREE_H
+#define COMPACT_TREE_H
+#include "nodedata.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+class CompactBinTree {
+
+    private:
+        // Index used in place of a null child pointer
+        static const uint32_t NULL_INDEX = 0xFFFFFFFFu;
+
+        // The CompactNode struct is one node of the tree, left and right are pool indices of the
+        // children and the key is keyLength bytes starting at keyOffset in the key buffer
+        struct CompactNode {
+            uint32_t left;
+            uint32_t right;
+            uint32_t keyOffset;
+            uint32_t keyLength;
+        };
+
+        // The node pool, the packed key bytes, and the pool index of the root
+        vector<CompactNode> nodes;
+        vector<char> keyBytes;
+        uint32_t root;
+
+    // Helper methods for comparing a key against a node and finding a key
+    int compareKey(const string& key, uint32_t nodeIndex) const;
+    uint32_t findNode(const string& key) const;
+
+    // Recursive helper methods for getHeight, the overloaded operators and displaySideways
+    int getHeightRecursiveHelper(uint32_t nodeIndex) const;
+    bool equalityHelper(uint32_t currentIndex, const CompactBinTree& otherTree, uint32_t otherIndex) const;
+    void inorderHelper(ostream& out, uint32_t nodeIndex) const;
+    void sideways(uint32_t nodeIndex, int level) const;
+
+    // Helper method for read that checks the indices and key ranges of a loaded tree
+    bool isValidTree() const;
+
+    public:
+        // Compact tree constructor, copies are plain copies of the two buffers
+        CompactBinTree();
+
+        // makeEmpty removes every key, isEmpty checks whether there are any, size counts them
+        void makeEmpty();
+        bool isEmpty() const;
+        int size() const;
+
+        // Overloaded ==, !=, << operators
+        bool operator==(const CompactBinTree &otherTree) const;
+        bool operator!=(const CompactBinTree &otherTree) const;
+        friend ostream& operator<<(ostream& out, const CompactBinTree &compactTree);
+
+        // Insert copies the key of newNodeData into the pool, it returns false for a duplicate
+        // or if the 32-bit indices and offsets would overflow
+        bool insert(const NodeData &newNodeData);
+
+        // Retrieve checks for targetNodeData, the second version also copies the stored key out
+        bool retrieve(const NodeData &targetNodeData) const;
+        bool retrieve(const NodeData &targetNodeData, NodeData &retrievedNodeData) const;
+
+        // Method to display the tree sideways
+        void displaySideways() const;
+
+        // Method to get the height of a given node in the tree
+        int getHeight(const NodeData &nodeData) const;
+
+        // Saves the tree as raw pool and key buffers, and loads it back, in the machine's byte order,
+        // read returns false and leaves the tree empty for input that is not a valid saved tree
+        void write(ostream& out) const;
+        bool read(istream& in);
+
+        // Returns the bytes used by the tree's buffers
+        size_t memoryFootprint() const;
+};
+
+#endif
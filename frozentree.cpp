@@ -0,0 +1,245 @@
+// --------------------------- frozentree.cpp --------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The frozentree.cpp file is the implementation file for the
+// FrozenBinTree class, the immutable Eytzinger ordered snapshot of a
+// binary search tree that is created by BinTree::freeze().
+// ---------------------------------------------------------------------
+// Notes - Every lookup is built on lowerBoundRank, which walks the implicit
+// tree from slot 1, going to slot 2k when the key at slot k is not less than
+// the target and to slot 2k + 1 otherwise. When the walk falls off the bottom,
+// the last left turn is recovered from the low bits of the slot index.
+// ---------------------------------------------------------------------
+#include "frozentree.h"
+#include "prefetch.h"
+#include <iostream>
+using namespace std;
+
+// -----------------------------[Default Constructor]-----------------------------------------
+// Description: The default constructor for the FrozenBinTree class creates an empty snapshot.
+// -------------------------------------------------------------------------------------------
+FrozenBinTree::FrozenBinTree()
+{
+	// Slot 0 is never used, it only keeps the children of slot k at 2k and 2k + 1
+	slotCount = 1;
+	prefixLines.resize(1);
+	slotRanks.resize(1);
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[Constructor]--------------------------------------------
+// Description: This constructor for the FrozenBinTree class takes ownership of a vector of
+// keys that is already sorted with no duplicates (such as an inorder walk of a BinTree)
+// and lays the keys out in Eytzinger order.
+// -------------------------------------------------------------------------------------------
+FrozenBinTree::FrozenBinTree(vector<NodeData> sortedNodeData) : sortedNodeData(std::move(sortedNodeData))
+{
+	// One slot per key plus the unused slot 0
+	slotCount = this->sortedNodeData.size() + 1;
+	prefixLines.resize((slotCount + PREFIXES_PER_LINE - 1) / PREFIXES_PER_LINE);
+	slotRanks.resize(slotCount);
+
+	// Fill the slots with an inorder walk of the implicit tree, handing out ranks in increasing order
+	uint32_t nextRank = 0;
+	buildHelper(1, nextRank);
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[buildHelper]--------------------------------------------
+// Description: The buildHelper method is the recursive helper method for the constructor,
+// it visits the implicit tree rooted at slotIndex in inorder, so the slots receive the
+// sorted keys from smallest to largest.
+// -------------------------------------------------------------------------------------------
+void FrozenBinTree::buildHelper(size_t slotIndex, uint32_t& nextRank)
+{
+	// Slots past the number of keys are not part of the tree
+	if (slotIndex >= slotCount)
+	{
+		return;
+	}
+
+	// Left subtree, then this slot, then the right subtree
+	buildHelper(2 * slotIndex, nextRank);
+
+	prefixLines[slotIndex / PREFIXES_PER_LINE].prefix[slotIndex % PREFIXES_PER_LINE] =
+		sortedNodeData[nextRank].getPrefix();
+	slotRanks[slotIndex] = nextRank;
+	nextRank++;
+
+	buildHelper(2 * slotIndex + 1, nextRank);
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[prefixAt]----------------------------------------------
+// Description: The prefixAt method returns the inline key prefix stored in slot slotIndex.
+// -------------------------------------------------------------------------------------------
+uint64_t FrozenBinTree::prefixAt(size_t slotIndex) const
+{
+	return prefixLines[slotIndex / PREFIXES_PER_LINE].prefix[slotIndex % PREFIXES_PER_LINE];
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[size]-------------------------------------------------
+// Description: The size method returns the number of keys in the snapshot.
+// -------------------------------------------------------------------------------------------
+int FrozenBinTree::size() const
+{
+	return static_cast<int>(sortedNodeData.size());
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[isEmpty]-----------------------------------------------
+// Description: The isEmpty method returns true if the snapshot holds no keys.
+// -------------------------------------------------------------------------------------------
+bool FrozenBinTree::isEmpty() const
+{
+	return sortedNodeData.empty();
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[lowerBoundRank]-------------------------------------------
+// Description: The lowerBoundRank method returns the rank of the first key that is not less
+// than targetNodeData, or the number of keys if every key is less. The descent compares the
+// inline prefixes and only looks at the full key when the prefixes tie, and it prefetches
+// the 16 slots four levels below the current one, whose prefixes fill two cache lines.
+// -------------------------------------------------------------------------------------------
+uint32_t FrozenBinTree::lowerBoundRank(const NodeData& targetNodeData) const
+{
+	const size_t keyCount = sortedNodeData.size();
+	const uint64_t targetPrefix = targetNodeData.getPrefix();
+	size_t slotIndex = 1;
+
+	while (slotIndex <= keyCount)
+	{
+		// The 16 descendants four levels down are slots 16k to 16k + 15, which are
+		// exactly lines 2k and 2k + 1, start loading both of them now
+		const size_t lineIndex = 2 * slotIndex;
+		if (lineIndex < prefixLines.size())
+		{
+			PREFETCH_READ(&prefixLines[lineIndex]);
+		}
+		if (lineIndex + 1 < prefixLines.size())
+		{
+			PREFETCH_READ(&prefixLines[lineIndex + 1]);
+		}
+
+		// Go right when the slot's key is less than the target, computed from the prefixes
+		// without a branch, the full keys are only compared on the rare prefix tie
+		const uint64_t slotPrefix = prefixAt(slotIndex);
+		const bool prefixTie = (slotPrefix == targetPrefix);
+		bool tieBreak = false;
+		if (UNLIKELY(prefixTie))
+		{
+			tieBreak = sortedNodeData[slotRanks[slotIndex]] < targetNodeData;
+		}
+		const size_t goRight = static_cast<size_t>(slotPrefix < targetPrefix) |
+			static_cast<size_t>(prefixTie & tieBreak);
+		slotIndex = 2 * slotIndex + goRight;
+	}
+
+	// The trailing 1 bits of slotIndex are the right turns taken after the last left turn,
+	// shifting them and the left turn away leaves the slot where the walk last went left
+#if defined(__GNUC__) || defined(__clang__)
+	slotIndex >>= __builtin_ctzll(~static_cast<unsigned long long>(slotIndex)) + 1;
+#else
+	while (slotIndex & 1)
+	{
+		slotIndex >>= 1;
+	}
+	slotIndex >>= 1;
+#endif
+
+	// Slot 0 means the walk never went left, so every key is less than the target
+	if (slotIndex == 0)
+	{
+		return static_cast<uint32_t>(keyCount);
+	}
+	return slotRanks[slotIndex];
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[retrieve]----------------------------------------------
+// Description: The retrieve method searches the snapshot for targetNodeData, it sets
+// retrievedNodeData to the stored key and returns true if it was found, otherwise it sets
+// retrievedNodeData to nullptr and returns false.
+// -------------------------------------------------------------------------------------------
+bool FrozenBinTree::retrieve(const NodeData& targetNodeData, const NodeData* &retrievedNodeData) const
+{
+	// The target is present exactly when the first key not less than it is equal to it
+	uint32_t targetRank = lowerBoundRank(targetNodeData);
+	if (targetRank < sortedNodeData.size() && sortedNodeData[targetRank] == targetNodeData)
+	{
+		retrievedNodeData = &sortedNodeData[targetRank];
+		return true;
+	}
+
+	retrievedNodeData = nullptr;
+	return false;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[lowerBound]---------------------------------------------
+// Description: The lowerBound method returns the smallest key in the snapshot that is not
+// less than targetNodeData, or nullptr if every key is less than targetNodeData.
+// -------------------------------------------------------------------------------------------
+const NodeData* FrozenBinTree::lowerBound(const NodeData& targetNodeData) const
+{
+	uint32_t targetRank = lowerBoundRank(targetNodeData);
+	if (targetRank < sortedNodeData.size())
+	{
+		return &sortedNodeData[targetRank];
+	}
+	return nullptr;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[rank]------------------------------------------------
+// Description: The rank method returns the number of keys in the snapshot that are less
+// than targetNodeData.
+// -------------------------------------------------------------------------------------------
+int FrozenBinTree::rank(const NodeData& targetNodeData) const
+{
+	return static_cast<int>(lowerBoundRank(targetNodeData));
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[memoryFootprint]-------------------------------------------
+// Description: The memoryFootprint method returns the number of bytes the snapshot uses,
+// counting the prefix and rank arrays, the key array and any key strings too long to be
+// stored inside their string object.
+// -------------------------------------------------------------------------------------------
+size_t FrozenBinTree::memoryFootprint() const
+{
+	size_t footprint = sizeof(*this) + prefixLines.capacity() * sizeof(PrefixLine) +
+		slotRanks.capacity() * sizeof(uint32_t) + sortedNodeData.capacity() * sizeof(NodeData);
+
+	// Strings that fit in the small string buffer of an empty string need no extra allocation
+	const size_t inlineCapacity = string().capacity();
+	for (size_t i = 0; i < sortedNodeData.size(); i++)
+	{
+		if (sortedNodeData[i].getData().capacity() > inlineCapacity)
+		{
+			footprint += sortedNodeData[i].getData().capacity() + 1;
+		}
+	}
+	return footprint;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator<<]---------------------------------------------
+// Description: The overloaded output operator prints the keys of the snapshot in sorted
+// order separated by spaces, followed by a newline, the same way BinTree does.
+// -------------------------------------------------------------------------------------------
+ostream& operator<<(ostream& out, const FrozenBinTree& frozenTree)
+{
+	for (size_t i = 0; i < frozenTree.sortedNodeData.size(); i++)
+	{
+		out << frozenTree.sortedNodeData[i] << " ";
+	}
+	out << endl;
+	return out;
+}
+// -------------------------------------------------------------------------------------------
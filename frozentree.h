@@ -0,0 +1,84 @@
+// ---------------------------- frozentree.h ---------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The frozentree.h file is the header file for the FrozenBinTree
+// class, an immutable read-optimized snapshot of a BinTree that is created
+// by BinTree::freeze(). It supports retrieve, lowerBound and rank lookups.
+// ---------------------------------------------------------------------
+// Notes - The snapshot stores the first 8 bytes of each key as an integer
+// prefix in one contiguous array in Eytzinger (breadth-first) order, packed
+// 8 to a cache line, so the first levels of every search share the same few
+// lines and the next levels can be prefetched. The ranks live in a separate
+// array that is only read once the search ends. Most comparisons never touch
+// the NodeData itself, the direction at each level is computed from the
+// prefixes without a branch, and only a prefix tie takes a (rare) branch to
+// compare the full keys.
+// ---------------------------------------------------------------------
+#ifndef FROZEN_TREE_H
+#define FROZEN_TREE_H
+#include "nodedata.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+class FrozenBinTree {
+
+    private:
+        // The PrefixLine struct is one cache line of the Eytzinger array, it holds the
+        // key prefixes of 8 consecutive slots, so slot k is prefix k % 8 of line k / 8
+        static const size_t PREFIXES_PER_LINE = 8;
+        struct alignas(64) PrefixLine {
+            uint64_t prefix[PREFIXES_PER_LINE];
+        };
+
+        // Eytzinger ordered key prefixes, slot 0 is unused so the children of slot k are 2k and 2k + 1
+        vector<PrefixLine> prefixLines;
+
+        // The rank (sorted index) of the full key in each slot
+        vector<uint32_t> slotRanks;
+
+        // Number of slots, one per key plus the unused slot 0
+        size_t slotCount;
+
+        // The full keys in sorted order, indexed by rank
+        vector<NodeData> sortedNodeData;
+
+    // Helper method that fills the slots with an inorder walk of the implicit tree
+    void buildHelper(size_t slotIndex, uint32_t& nextRank);
+
+    // Helper method that returns the key prefix stored in a slot
+    uint64_t prefixAt(size_t slotIndex) const;
+
+    // Helper method that returns the rank of the first key that is not less than targetNodeData
+    uint32_t lowerBoundRank(const NodeData& targetNodeData) const;
+
+    public:
+        // Frozen tree constructors, sortedNodeData must be sorted and have no duplicates
+        FrozenBinTree();
+        explicit FrozenBinTree(vector<NodeData> sortedNodeData);
+
+        // Returns the number of keys and whether the snapshot is empty
+        int size() const;
+        bool isEmpty() const;
+
+        // Finds targetNodeData, sets retrievedNodeData to the stored key or nullptr
+        bool retrieve(const NodeData& targetNodeData, const NodeData* &retrievedNodeData) const;
+
+        // Returns the smallest key not less than targetNodeData, or nullptr if there is none
+        const NodeData* lowerBound(const NodeData& targetNodeData) const;
+
+        // Returns the number of keys that are less than targetNodeData
+        int rank(const NodeData& targetNodeData) const;
+
+        // Returns the bytes used by the snapshot, including the key strings
+        size_t memoryFootprint() const;
+
+        // Overloaded << operator prints the keys in sorted order
+        friend ostream& operator<<(ostream& out, const FrozenBinTree& frozenTree);
+};
+
+#endif
@@ -0,0 +1,373 @@
+// ----------------------------- ingest.cpp ----------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The ingest.cpp file is the implementation file for
+// ingestTrees, the pipelined reader, tokenizer and inserter that build
+// a BinTree for every "$$" terminated segment of an input stream, and for
+// the output operator of its IngestStats.
+// ---------------------------------------------------------------------
+// Notes - The reader and tokenizer each run on their own thread and the
+// inserter runs on the calling thread, which owns the trees. A stage that
+// finds its output queue full or its input queue empty yields until the
+// other side catches up, and that time is its stall time. A token that is
+// cut in two by a chunk boundary is simply continued from the next chunk,
+// since the tokenizer only closes a batch between tokens. If any stage
+// throws, the others are told to stop, both threads are joined, and the
+// exception is passed on to the caller of ingestTrees.
+// ---------------------------------------------------------------------
+#include "ingest.h"
+#include "spscqueue.h"
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <thread>
+using namespace std;
+
+// The TokenBatch struct is the unit the tokenizer hands to the inserter, the tokens are stored
+// end to end in characters and token i ends at tokenEnds[i] (and starts where token i - 1 ends)
+struct TokenBatch {
+	string characters;
+	vector<size_t> tokenEnds;
+};
+
+// The PipelineControl struct is shared by the three stages, stopRequested tells every stage to
+// give up early, and a stage thread that throws keeps its exception here for ingestTrees
+struct PipelineControl {
+	atomic<bool> stopRequested{ false };
+	exception_ptr readerError;
+	exception_ptr tokenizerError;
+};
+
+// The StageThreads struct owns the reader and tokenizer threads so that they are joined on
+// every path out of ingestTrees, if the inserter throws the destructor stops them first
+struct StageThreads {
+	PipelineControl& control;
+	thread reader;
+	thread tokenizer;
+
+	explicit StageThreads(PipelineControl& pipelineControl) : control(pipelineControl)
+	{
+	}
+
+	~StageThreads()
+	{
+		control.stopRequested = true;
+		join();
+	}
+
+	void join()
+	{
+		if (reader.joinable())
+		{
+			reader.join();
+		}
+		if (tokenizer.joinable())
+		{
+			tokenizer.join();
+		}
+	}
+};
+
+// Returns the seconds from start until now
+static double secondsSince(chrono::steady_clock::time_point start)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// ------------------------------[pushWithBackpressure]---------------------------------------
+// Description: The pushWithBackpressure function pushes item onto queue, yielding the thread
+// while the queue is full, and adds the time spent waiting to stallSeconds. It returns false
+// without pushing if the pipeline is asked to stop while it waits.
+// -------------------------------------------------------------------------------------------
+template <class T>
+static bool pushWithBackpressure(SpscQueue<T>& queue, T&& item, double& stallSeconds, const atomic<bool>& stopRequested)
+{
+	if (queue.tryPush(std::move(item)))
+	{
+		return true;
+	}
+
+	chrono::steady_clock::time_point stallStart = chrono::steady_clock::now();
+	bool pushed = false;
+	while (!pushed && !stopRequested)
+	{
+		this_thread::yield();
+		pushed = queue.tryPush(std::move(item));
+	}
+	stallSeconds += secondsSince(stallStart);
+	return pushed;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[popOrFinish]---------------------------------------------
+// Description: The popOrFinish function pops the next item of queue into item, yielding the
+// thread while the queue is empty, and adds the time spent waiting to stallSeconds. It
+// returns false once the queue is closed and empty, or the pipeline is asked to stop.
+// -------------------------------------------------------------------------------------------
+template <class T>
+static bool popOrFinish(SpscQueue<T>& queue, T& item, double& stallSeconds, const atomic<bool>& stopRequested)
+{
+	if (stopRequested)
+	{
+		return false;
+	}
+	if (queue.tryPop(item))
+	{
+		return true;
+	}
+
+	chrono::steady_clock::time_point stallStart = chrono::steady_clock::now();
+	bool popped = false;
+	while (!popped)
+	{
+		popped = queue.tryPop(item);
+		if (!popped && (queue.isFinished() || stopRequested))
+		{
+			break;
+		}
+		if (!popped)
+		{
+			this_thread::yield();
+		}
+	}
+	stallSeconds += secondsSince(stallStart);
+	return popped;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[readerStage]--------------------------------------------
+// Description: The readerStage function reads in until the end of the stream, chunkBytes at
+// a time, and pushes each chunk onto chunkQueue, closing it at the end or when asked to stop.
+// -------------------------------------------------------------------------------------------
+static void readerStage(istream& in, SpscQueue<string>& chunkQueue, size_t chunkBytes, IngestStageStats& stageStats, const atomic<bool>& stopRequested)
+{
+	chrono::steady_clock::time_point stageStart = chrono::steady_clock::now();
+
+	while (in && !stopRequested)
+	{
+		string chunk(chunkBytes, '\0');
+		in.read(&chunk[0], static_cast<streamsize>(chunkBytes));
+		size_t bytesRead = static_cast<size_t>(in.gcount());
+		if (bytesRead == 0)
+		{
+			break;
+		}
+		chunk.resize(bytesRead);
+
+		stageStats.items++;
+		stageStats.bytes += bytesRead;
+		if (!pushWithBackpressure(chunkQueue, std::move(chunk), stageStats.stallSeconds, stopRequested))
+		{
+			break;
+		}
+	}
+
+	chunkQueue.close();
+	stageStats.seconds = secondsSince(stageStart);
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[tokenizerStage]-------------------------------------------
+// Description: The tokenizerStage function cuts the chunks of chunkQueue into whitespace
+// separated tokens, the same tokens that operator>> would read, and pushes them onto
+// batchQueue in batches of batchTokens, closing it after the last, partly full batch. When
+// asked to stop it drops what it has and closes batchQueue.
+// -------------------------------------------------------------------------------------------
+static void tokenizerStage(SpscQueue<string>& chunkQueue, SpscQueue<TokenBatch>& batchQueue, size_t batchTokens, IngestStageStats& stageStats, const atomic<bool>& stopRequested)
+{
+	chrono::steady_clock::time_point stageStart = chrono::steady_clock::now();
+
+	TokenBatch batch;
+	bool inToken = false;
+	string chunk;
+
+	while (popOrFinish(chunkQueue, chunk, stageStats.stallSeconds, stopRequested))
+	{
+		stageStats.bytes += chunk.size();
+		for (char character : chunk)
+		{
+			if (!isspace(static_cast<unsigned char>(character)))
+			{
+				batch.characters.push_back(character);
+				inToken = true;
+				continue;
+			}
+			if (!inToken)
+			{
+				continue;
+			}
+
+			// Whitespace ends the current token, and a full batch is handed on
+			inToken = false;
+			batch.tokenEnds.push_back(batch.characters.size());
+			stageStats.items++;
+			if (batch.tokenEnds.size() >= batchTokens)
+			{
+				// A failed push means the pipeline is stopping, which the next pop sees too
+				if (!pushWithBackpressure(batchQueue, std::move(batch), stageStats.stallSeconds, stopRequested))
+				{
+					break;
+				}
+				batch = TokenBatch();
+			}
+		}
+	}
+
+	// The end of the stream ends the last token too
+	if (inToken)
+	{
+		batch.tokenEnds.push_back(batch.characters.size());
+		stageStats.items++;
+	}
+	if (!batch.tokenEnds.empty() && !stopRequested)
+	{
+		pushWithBackpressure(batchQueue, std::move(batch), stageStats.stallSeconds, stopRequested);
+	}
+
+	batchQueue.close();
+	stageStats.seconds = secondsSince(stageStart);
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[runStage]----------------------------------------------
+// Description: The runStage function runs stage on the current thread. If it throws, the
+// exception is kept in stageError, the rest of the pipeline is asked to stop, and the
+// stage's outputQueue is closed so the stage after it does not wait for it forever.
+// -------------------------------------------------------------------------------------------
+template <class T, class Stage>
+static void runStage(Stage stage, SpscQueue<T>& outputQueue, PipelineControl& control, exception_ptr& stageError)
+{
+	try
+	{
+		stage();
+	}
+	catch (...)
+	{
+		stageError = current_exception();
+		control.stopRequested = true;
+		outputQueue.close();
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[ingestTrees]-------------------------------------------
+// Description: The ingestTrees function starts the reader and tokenizer threads and inserts
+// the tokens of each batch into the current tree on the calling thread. A "$$" token moves
+// the current tree onto the end of trees and starts a new one, and a final segment that has
+// tokens but no "$$" is added at the end as well. It returns the statistics of the run. If
+// a stage throws, both threads are stopped and joined before the exception is passed on,
+// and trees then holds the trees finished before the failure.
+// -------------------------------------------------------------------------------------------
+IngestStats ingestTrees(istream& in, vector<BinTree>& trees, const IngestOptions& options)
+{
+	IngestStats ingestStats = IngestStats();
+	chrono::steady_clock::time_point runStart = chrono::steady_clock::now();
+
+	size_t batchTokens = (options.batchTokens > 0) ? options.batchTokens : 1;
+	size_t chunkBytes = (options.chunkBytes > 0) ? options.chunkBytes : 1;
+	SpscQueue<string> chunkQueue(options.queueCapacity);
+	SpscQueue<TokenBatch> batchQueue(options.queueCapacity);
+
+	PipelineControl control;
+	StageThreads stageThreads(control);
+	stageThreads.reader = thread([&] {
+		runStage([&] { readerStage(in, chunkQueue, chunkBytes, ingestStats.reader, control.stopRequested); },
+			chunkQueue, control, control.readerError);
+	});
+	stageThreads.tokenizer = thread([&] {
+		runStage([&] { tokenizerStage(chunkQueue, batchQueue, batchTokens, ingestStats.tokenizer, control.stopRequested); },
+			batchQueue, control, control.tokenizerError);
+	});
+
+	// The inserter stage, currentTree collects the keys of the current segment
+	IngestStageStats& stageStats = ingestStats.inserter;
+	chrono::steady_clock::time_point stageStart = chrono::steady_clock::now();
+	BinTree currentTree;
+	currentTree.setCountingMode(options.countingMode);
+	bool segmentHasTokens = false;
+	TokenBatch batch;
+
+	while (popOrFinish(batchQueue, batch, stageStats.stallSeconds, control.stopRequested))
+	{
+		string_view characters(batch.characters);
+		size_t tokenStart = 0;
+		for (size_t tokenEnd : batch.tokenEnds)
+		{
+			string_view token = characters.substr(tokenStart, tokenEnd - tokenStart);
+			tokenStart = tokenEnd;
+			stageStats.items++;
+			stageStats.bytes += token.size();
+
+			if (token == "$$")
+			{
+				trees.push_back(std::move(currentTree));
+				ingestStats.treesBuilt++;
+				currentTree = BinTree();
+				currentTree.setCountingMode(options.countingMode);
+				segmentHasTokens = false;
+				continue;
+			}
+
+			segmentHasTokens = true;
+			if (currentTree.emplace(token))
+			{
+				ingestStats.keysInserted++;
+			}
+		}
+	}
+	if (segmentHasTokens && !control.stopRequested)
+	{
+		trees.push_back(std::move(currentTree));
+		ingestStats.treesBuilt++;
+	}
+	stageStats.seconds = secondsSince(stageStart);
+
+	stageThreads.join();
+	if (control.readerError)
+	{
+		rethrow_exception(control.readerError);
+	}
+	if (control.tokenizerError)
+	{
+		rethrow_exception(control.tokenizerError);
+	}
+
+	ingestStats.seconds = secondsSince(runStart);
+	return ingestStats;
+}
+// -------------------------------------------------------------------------------------------
+
+// Prints one row of the stage table, with the stage's rates taken over its own run time
+static void printStageRow(ostream& out, const char* stageName, const char* itemName, const IngestStageStats& stageStats)
+{
+	double seconds = (stageStats.seconds > 0) ? stageStats.seconds : 1e-9;
+	out << "  " << left << setw(10) << stageName << right
+		<< setw(12) << stageStats.items << ' ' << left << setw(7) << itemName << right
+		<< setw(10) << fixed << setprecision(1) << stageStats.bytes / seconds / 1e6 << " MB/s"
+		<< setw(12) << setprecision(0) << stageStats.items / seconds << " " << itemName << "/s"
+		<< "   stalled " << setprecision(3) << stageStats.stallSeconds << "s of " << stageStats.seconds << "s" << endl;
+	out.unsetf(ios::floatfield);
+	out << setprecision(6);
+}
+
+// ----------------------------------[operator<<]---------------------------------------------
+// Description: The overloaded output operator prints the statistics of an ingest run, one
+// line for each stage with its item count, byte and item throughput, and stall time.
+// -------------------------------------------------------------------------------------------
+ostream& operator<<(ostream& out, const IngestStats &ingestStats)
+{
+	out << "Ingest: " << ingestStats.treesBuilt << " trees, " << ingestStats.keysInserted
+		<< " keys inserted in " << ingestStats.seconds << "s" << endl;
+	printStageRow(out, "reader", "chunks", ingestStats.reader);
+	printStageRow(out, "tokenizer", "tokens", ingestStats.tokenizer);
+	printStageRow(out, "inserter", "tokens", ingestStats.inserter);
+	return out;
+}
+// -------------------------------------------------------------------------------------------
@@ -0,0 +1,67 @@
+// ------------------------------ ingest.h -----------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The ingest.h file declares ingestTrees, a pipelined version
+// of the driver's buildTree loop that builds one BinTree for every "$$"
+// terminated segment of an input stream, and the IngestStats struct it
+// reports with.
+// ---------------------------------------------------------------------
+// Notes - The work is split into three stages that run at the same time.
+// A reader thread reads the stream in large chunks, a tokenizer thread
+// cuts the chunks into whitespace separated tokens and packs them into
+// batches, and the calling thread inserts the batches into the trees.
+// The stages are connected by bounded SpscQueues, so a stage that gets
+// ahead waits for the next one instead of buffering the whole input, and
+// each stage records how long it spent waiting. Tokens are handed over in
+// batches that share one character buffer, so queue traffic and string
+// allocations are per batch rather than per token, and the inserter
+// passes string_views to BinTree::emplace, so a repeated token allocates
+// nothing. Unlike buildTree, nothing is echoed to cout.
+// ---------------------------------------------------------------------
+#ifndef INGEST_H
+#define INGEST_H
+#include "bintree.h"
+#include <cstddef>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// The IngestOptions struct holds the tuning knobs of ingestTrees, the defaults suit large inputs
+struct IngestOptions {
+    size_t chunkBytes = 64 * 1024;      // bytes the reader reads at a time
+    size_t batchTokens = 1024;          // tokens the tokenizer packs into one batch
+    size_t queueCapacity = 16;          // chunks or batches each queue holds before the stage before it waits
+    bool countingMode = false;          // build the trees in counting mode, see BinTree::setCountingMode
+};
+
+// The IngestStageStats struct reports one stage of the pipeline
+struct IngestStageStats {
+    unsigned long long items;           // chunks read, or tokens tokenized or inserted
+    unsigned long long bytes;           // bytes read, tokenized or inserted
+    double seconds;                     // time from the start of the stage until it finished
+    double stallSeconds;                // part of that time spent waiting on a full or empty queue
+};
+
+// The IngestStats struct reports a whole ingestTrees run
+struct IngestStats {
+    IngestStageStats reader;
+    IngestStageStats tokenizer;
+    IngestStageStats inserter;
+    unsigned long long treesBuilt;      // trees appended to the output vector
+    unsigned long long keysInserted;    // tokens that were new keys in their tree
+    double seconds;                     // wall clock time of the whole run
+};
+
+// Prints the per-stage item and byte throughput and stall time of an ingest run
+ostream& operator<<(ostream& out, const IngestStats &ingestStats);
+
+// Reads whitespace separated tokens from in until the end of the stream and appends one
+// BinTree to trees for every segment ending in "$$", and one more for a final segment that
+// has tokens but no "$$". An exception thrown while reading the stream is passed on after
+// both stage threads are joined
+IngestStats ingestTrees(istream& in, vector<BinTree>& trees, const IngestOptions& options = IngestOptions());
+
+#endif
@@ -2,7 +2,7 @@
 // David Schurer
 // CSS 343
 // Creation Date: 4/12/2023
-// Date of Last Modification: 4/20/2023
+// Date of Last Modification: 10/19/2026
 // ---------------------------------------------------------------------
 // Purpose - The lab2.cpp file is the driver file that is used to test
 // the methods of the binary search tree class BinTree and the node data
@@ -17,9 +17,13 @@
 // initArray. The buildTree method will read in the strings from the 
 // data2.txt input file and inserts these strings into the binary search tree
 // until it reads $$ in the input file. The initArray method initializes an
-// array of NodeData pointers to null pointers.
+// array of NodeData pointers to null pointers. Run as "lab2 --ingest [file]",
+// the driver instead builds every tree of the file (data2.txt by default)
+// with the pipelined ingestTrees, without echoing the strings, and prints
+// the size of each tree and the throughput and stall time of each stage.
 // ---------------------------------------------------------------------
 #include "bintree.h"
+#include "ingest.h"
 #include <fstream>
 #include <iostream>
 using namespace std;
@@ -29,8 +33,13 @@ const int ARRAYSIZE = 100;
 //global function prototypes
 void buildTree(BinTree&, ifstream&);      // 
 void initArray(NodeData*[]);             // initialize array to NULL
+int runIngest(const char*);              // pipelined build of every tree in a file
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && string(argv[1]) == "--ingest") {
+		return runIngest(argc > 2 ? argv[2] : "data2.txt");
+	}
 
-int main() {
 	// create file object infile and open it
 	// for testing, call your data file something appropriate, e.g., data2.txt
 	ifstream infile("data2.txt");
@@ -39,17 +48,6 @@ int main() {
 		return 1;
 	}
 
-	// the NodeData class must have a constructor that takes a string
-	NodeData notND("not");
-	NodeData andND("and");
-	NodeData sssND("sss");
-	NodeData ttttND("tttt");
-	NodeData oooND("ooo");
-	NodeData yND("y");
-	NodeData eND("e");
-	NodeData mND("m");
-	NodeData tND("t");
-
 	BinTree T, T2, dup;
 	NodeData* ndArray[ARRAYSIZE];
 	initArray(ndArray);
@@ -62,23 +60,24 @@ int main() {
 		cout << "Tree Inorder:" << endl << T;          // operator<< does endl
 		T.displaySideways();
 
-		// test retrieve 
+		// test retrieve, the keys are looked up as plain strings so no
+		// NodeData has to be built for them
 		NodeData* p;                    // pointer of retrieved object
 		bool found;                     // whether or not object was found in tree
-		found = T.retrieve(andND, p);
+		found = T.retrieve("and", p);
 		cout << "Retrieve --> and:  " << (found ? "found" : "not found") << endl;
-		found = T.retrieve(notND, p);
+		found = T.retrieve("not", p);
 		cout << "Retrieve --> not:  " << (found ? "found" : "not found") << endl;
-		found = T.retrieve(sssND, p);
+		found = T.retrieve("sss", p);
 		cout << "Retrieve --> sss:  " << (found ? "found" : "not found") << endl;
 
 		// test getHeight 
-		cout << "Height    --> and:  " << T.getHeight(andND) << endl;
-		cout << "Height    --> not:  " << T.getHeight(notND) << endl;
-		cout << "Height    --> sss:  " << T.getHeight(sssND) << endl;
-		cout << "Height    --> tttt:  " << T.getHeight(ttttND) << endl;
-		cout << "Height    --> ooo:  " << T.getHeight(oooND) << endl;
-		cout << "Height    --> y:  " << T.getHeight(yND) << endl;
+		cout << "Height    --> and:  " << T.getHeight("and") << endl;
+		cout << "Height    --> not:  " << T.getHeight("not") << endl;
+		cout << "Height    --> sss:  " << T.getHeight("sss") << endl;
+		cout << "Height    --> tttt:  " << T.getHeight("tttt") << endl;
+		cout << "Height    --> ooo:  " << T.getHeight("ooo") << endl;
+		cout << "Height    --> y:  " << T.getHeight("y") << endl;
 
 		// test ==, and != 
 		T2 = T;
@@ -119,13 +118,33 @@ void buildTree(BinTree& T, ifstream& infile) {
 		cout << s << ' ';
 		if (s == "$$") break;                // at end of one line
 		if (infile.eof()) break;             // no more lines of data
-		NodeData* ptr = new NodeData(s);     // NodeData constructor takes string
-		// would do a setData if there were more than a string
 
-		bool success = T.insert(ptr);
-		if (!success)
-			delete ptr;                       // duplicate case, not inserted 
+		// emplace builds the NodeData from the string inside the tree, so
+		// nothing is allocated (or left to delete) in the duplicate case
+		T.emplace(s);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[runIngest]----------------------------------------------
+// Description: The runIngest global method builds one tree for each "$$" terminated segment
+// of the named file with the pipelined ingestTrees, then prints the number of keys in each
+// tree and the statistics of the ingest. The strings themselves are not echoed.
+// -------------------------------------------------------------------------------------------
+int runIngest(const char* fileName) {
+	ifstream infile(fileName, ios::binary);
+	if (!infile) {
+		cout << "File could not be opened." << endl;
+		return 1;
 	}
+
+	vector<BinTree> trees;
+	IngestStats ingestStats = ingestTrees(infile, trees);
+	for (size_t i = 0; i < trees.size(); i++) {
+		cout << "Tree " << i << ": " << trees[i].shapeStats().nodeCount << " keys" << endl;
+	}
+	cout << ingestStats;
+	return 0;
 }
 // -------------------------------------------------------------------------------------------
 
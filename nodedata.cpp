@@ -2,7 +2,7 @@
 // David Schurer
 // CSS 343
 // Creation Date: 4/12/2023
-// Date of Last Modification: 4/20/2023
+// Date of Last Modification: 10/19/2026
 // ---------------------------------------------------------------------
 // Purpose - The nodedata.cpp file is the implementation file that provides
 // the implementation of all the methods of the NodeData class. This class
@@ -26,6 +26,10 @@ NodeData::NodeData(const NodeData& nd) { data = nd.data; }  // copy
 
 NodeData::NodeData(const string& s) { data = s; }    // cast string to NodeData
 
+NodeData::NodeData(string&& s) : data(std::move(s)) { }           // take string
+
+NodeData::NodeData(NodeData&& nd) noexcept : data(std::move(nd.data)) { }   // move
+
 //------------------------- operator= ----------------------------------------
 NodeData& NodeData::operator=(const NodeData& rhs) {
 	if (this != &rhs) {
@@ -34,6 +38,13 @@ NodeData& NodeData::operator=(const NodeData& rhs) {
 	return *this;
 }
 
+NodeData& NodeData::operator=(NodeData&& rhs) noexcept {
+	if (this != &rhs) {
+		data = std::move(rhs.data);
+	}
+	return *this;
+}
+
 //------------------------- operator==,!= ------------------------------------
 bool NodeData::operator==(const NodeData& rhs) const {
 	return data == rhs.data;
@@ -68,6 +79,30 @@ bool NodeData::setData(istream& infile) {
 	return !infile.eof();       // eof function is true when eof char is read
 }
 
+//------------------------------ getData -------------------------------------
+const string& NodeData::getData() const {
+	return data;
+}
+
+//----------------------------- getPrefix ------------------------------------
+// packs up to the first 8 characters into an integer, most significant byte
+// first, so integer order matches string order on everything but ties
+
+uint64_t NodeData::getPrefix() const {
+	uint64_t prefix = 0;
+	for (size_t i = 0; i < 8; i++) {
+		prefix <<= 8;
+		if (i < data.size())
+			prefix |= static_cast<unsigned char>(data[i]);
+	}
+	return prefix;
+}
+
+//------------------------------ compare -------------------------------------
+int NodeData::compare(string_view key) const {
+	return data.compare(key);
+}
+
 //-------------------------- operator<< --------------------------------------
 ostream& operator<<(ostream& output, const NodeData& nd) {
 	output << nd.data;
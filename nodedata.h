@@ -2,7 +2,7 @@
 // David Schurer
 // CSS 343
 // Creation Date: 4/12/2023
-// Date of Last Modification: 4/20/2023
+// Date of Last Modification: 10/19/2026
 // ---------------------------------------------------------------------
 // Purpose - The nodedata.h file is the header file for the node data
 // of each node that is stored in the binary search tree. This class
@@ -19,6 +19,8 @@
 #ifndef NODEDATA_H
 #define NODEDATA_H
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 using namespace std;
@@ -36,10 +38,28 @@ public:
 	NodeData(const NodeData &);    // copy constructor
 	NodeData& operator=(const NodeData &);
 
+	// move versions, they take over the string instead of copying it
+	NodeData(string &&);
+	NodeData(NodeData &&) noexcept;
+	NodeData& operator=(NodeData &&) noexcept;
+
 	// set class data from data file
 	// returns true if the data is set, false when bad data, i.e., is eof
 	bool setData(istream&);
 
+	// read-only access to the string, used by the read-optimized tree layouts
+	const string& getData() const;
+
+	// first 8 bytes of the string packed big-endian (zero padded), so that
+	// comparing two prefixes as integers orders them like the strings; equal
+	// prefixes mean the full strings still have to be compared
+	uint64_t getPrefix() const;
+
+	// compares the string with key without building a NodeData, returns a
+	// negative number, 0, or a positive number when the string is smaller,
+	// equal, or larger than key
+	int compare(string_view key) const;
+
 	bool operator==(const NodeData &) const;
 	bool operator!=(const NodeData &) const;
 	bool operator<(const NodeData &) const;
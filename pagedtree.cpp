@@ -0,0 +1,859 @@
+// ---------------------------- pagedtree.cpp --------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The pagedtree.cpp file is the implementation file for the
+// PagedBinTree class, it reads and writes the pages of the file, keeps the
+// most used ones in the CLOCK page cache, and inserts and searches keys in
+// the B+-tree the pages form.
+// ---------------------------------------------------------------------
+// Notes - A page in the file starts with an 8 byte header (1 byte leaf
+// flag, 1 unused byte, a 2 byte key count and the 4 byte next leaf page),
+// an inner page then has one more 4 byte child page number than it has
+// keys, and every page ends with its keys, each a 2 byte length followed
+// by the bytes of the key. The header page holds a magic value, the page
+// size, the number of pages, the root page, the height and the number of
+// keys. A page that grows past PAGE_SIZE is split in two at the middle of
+// its bytes, so pages stay about half full or more.
+// ---------------------------------------------------------------------
+#include "pagedtree.h"
+#include <algorithm>
+#include <cstring>
+using namespace std;
+
+// Marks the first bytes of a paged tree file, and the size of the page header
+static const char PAGED_TREE_MAGIC[4] = { 'P', 'B', 'T', '1' };
+static const size_t PAGE_HEADER_BYTES = 8;
+
+// ----------------------------------[PagedBinTree]-------------------------------------------
+// Description: The PagedBinTree constructor builds a tree with no file, create or open has
+// to be called before keys can be inserted.
+// -------------------------------------------------------------------------------------------
+PagedBinTree::PagedBinTree()
+{
+	fileOpen = false;
+	pageCount = 0;
+	rootPage = NULL_PAGE;
+	treeHeight = 0;
+	keyCount = 0;
+	clockHand = 0;
+	cacheCapacity = MIN_CACHE_PAGES;
+	counters = PageCacheStats();
+	ioError = false;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[~PagedBinTree]------------------------------------------
+// Description: The PagedBinTree destructor writes every changed page back and closes the file.
+// -------------------------------------------------------------------------------------------
+PagedBinTree::~PagedBinTree()
+{
+	close();
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------------[create]---------------------------------------------
+// Description: The create method replaces fileName with a new tree made of the header page
+// and one empty root leaf, and returns false if the file cannot be opened or written.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::create(const string& fileName, size_t cachePages)
+{
+	close();
+	file.open(fileName, ios::in | ios::out | ios::trunc | ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	fileOpen = true;
+	ioError = false;
+	cacheCapacity = (cachePages > MIN_CACHE_PAGES) ? cachePages : MIN_CACHE_PAGES;
+	frames.reserve(cacheCapacity);
+	counters = PageCacheStats();
+
+	// The cache is empty, so the first page always gets a frame
+	pageCount = 1;
+	newPage(true, rootPage);
+	unpinPage(rootPage);
+	treeHeight = 1;
+	keyCount = 0;
+	return flush();
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------------[open]----------------------------------------------
+// Description: The open method opens a tree that was saved in fileName, and returns false if
+// the file is missing or its header page is not one this class wrote with the same page size.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::open(const string& fileName, size_t cachePages)
+{
+	close();
+	file.open(fileName, ios::in | ios::out | ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	if (!readHeader())
+	{
+		file.close();
+		return false;
+	}
+
+	fileOpen = true;
+	ioError = false;
+	cacheCapacity = (cachePages > MIN_CACHE_PAGES) ? cachePages : MIN_CACHE_PAGES;
+	frames.reserve(cacheCapacity);
+	counters = PageCacheStats();
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------------[flush]---------------------------------------------
+// Description: The flush method writes every dirty page in the cache and the header page to
+// the file, so the file holds the whole tree. The pages stay in the cache. It returns false
+// if no file is open or a write failed, in which case the failed pages stay dirty.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::flush()
+{
+	if (!fileOpen)
+	{
+		return false;
+	}
+	bool isWritten = true;
+	for (Frame& frame : frames)
+	{
+		if (frame.dirty && !writeFrame(frame))
+		{
+			isWritten = false;
+		}
+	}
+	isWritten = writeHeader() && isWritten;
+	if (!file.flush())
+	{
+		file.clear();
+		ioError = true;
+		isWritten = false;
+	}
+	return isWritten;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------------[close]---------------------------------------------
+// Description: The close method flushes the tree, closes the file and empties the cache, and
+// returns false if the flush failed (closing with no file open does nothing and returns
+// true). isOpen returns whether there is an open file, and hasError whether a page could
+// not be read, decoded or written since the file was created or opened.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::close()
+{
+	if (!fileOpen)
+	{
+		return true;
+	}
+	bool isWritten = flush();
+	file.close();
+	fileOpen = false;
+	frames.clear();
+	frameOfPage.clear();
+	clockHand = 0;
+	pageCount = 0;
+	rootPage = NULL_PAGE;
+	treeHeight = 0;
+	keyCount = 0;
+	return isWritten;
+}
+
+bool PagedBinTree::isOpen() const
+{
+	return fileOpen;
+}
+
+bool PagedBinTree::hasError() const
+{
+	return ioError;
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------------[isEmpty]--------------------------------------------
+// Description: The isEmpty, size and getHeight methods return whether the tree has no keys,
+// the number of keys, and the number of levels of pages, all kept in the header.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::isEmpty() const
+{
+	return keyCount == 0;
+}
+
+uint64_t PagedBinTree::size() const
+{
+	return keyCount;
+}
+
+int PagedBinTree::getHeight() const
+{
+	return static_cast<int>(treeHeight);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[insert]----------------------------------------------
+// Description: The insert method walks from the root to the leaf the key belongs in,
+// remembering the pages on the way, and adds the key to the leaf in sorted order. If the
+// leaf no longer fits in a page it is split, and the separator key goes into the parent,
+// which may split in turn. When the root splits a new root is made above it, which is the
+// only way the tree gets taller, so every leaf stays at the same depth. A page that cannot
+// be read or written fails the insert, and since a split may then be left half done, no
+// more keys are taken until the file is opened again.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::insert(const NodeData &newNodeData)
+{
+	const string& newKey = newNodeData.getData();
+	if (!fileOpen || ioError || newKey.size() > MAX_KEY_BYTES)
+	{
+		return false;
+	}
+
+	// The pages from the root down to the leaf, so that splits can be passed up
+	vector<uint32_t> pagePath;
+	uint32_t pageId;
+	if (!findLeaf(newKey, pageId, &pagePath))
+	{
+		return false;
+	}
+	pagePath.push_back(pageId);
+
+	// A duplicate is found before the leaf is changed, so it costs no write
+	DecodedPage* leafPage = pinLeaf(pageId);
+	if (leafPage == nullptr)
+	{
+		return false;
+	}
+	vector<string>::iterator insertAt = lower_bound(leafPage->keys.begin(), leafPage->keys.end(), newKey);
+	if (insertAt != leafPage->keys.end() && *insertAt == newKey)
+	{
+		unpinPage(pageId);
+		return false;
+	}
+	leafPage->keys.insert(insertAt, newKey);
+	markDirty(pageId);
+	bool overflow = encodedSize(*leafPage) > PAGE_SIZE;
+	unpinPage(pageId);
+	keyCount++;
+
+	// Each split adds one key and one child to the page above it
+	for (size_t level = pagePath.size() - 1; overflow; level--)
+	{
+		string separatorKey;
+		uint32_t rightPageId;
+		if (!splitPage(pagePath[level], separatorKey, rightPageId))
+		{
+			return false;
+		}
+
+		if (level == 0)
+		{
+			uint32_t newRootId;
+			DecodedPage* newRoot = newPage(false, newRootId);
+			if (newRoot == nullptr)
+			{
+				return false;
+			}
+			newRoot->keys.push_back(std::move(separatorKey));
+			newRoot->children.push_back(rootPage);
+			newRoot->children.push_back(rightPageId);
+			unpinPage(newRootId);
+			rootPage = newRootId;
+			treeHeight++;
+			break;
+		}
+
+		uint32_t parentId = pagePath[level - 1];
+		DecodedPage* parentPage = pinPage(parentId, true);
+		if (parentPage == nullptr)
+		{
+			return false;
+		}
+		size_t separatorIndex = upper_bound(parentPage->keys.begin(), parentPage->keys.end(), separatorKey) - parentPage->keys.begin();
+		parentPage->keys.insert(parentPage->keys.begin() + separatorIndex, std::move(separatorKey));
+		parentPage->children.insert(parentPage->children.begin() + separatorIndex + 1, rightPageId);
+		overflow = encodedSize(*parentPage) > PAGE_SIZE;
+		unpinPage(parentId);
+	}
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[splitPage]--------------------------------------------
+// Description: The splitPage method moves the upper half (by bytes) of a page that is too
+// big into a new page, and returns the new page and the key that separates the two. A leaf
+// keeps a copy of its separator (the new page's first key) and links the new page into the
+// leaf chain, an inner page gives its middle key up and the children on each side of it go
+// with the keys on that side. It returns false if either page cannot be had.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::splitPage(uint32_t pageId, string& separatorKey, uint32_t& rightPageId)
+{
+	DecodedPage* leftPagePointer = pinPage(pageId, true);
+	if (leftPagePointer == nullptr)
+	{
+		return false;
+	}
+	DecodedPage& leftPage = *leftPagePointer;
+	DecodedPage* rightPagePointer = newPage(leftPage.isLeaf, rightPageId);
+	if (rightPagePointer == nullptr)
+	{
+		unpinPage(pageId);
+		return false;
+	}
+	DecodedPage& rightPage = *rightPagePointer;
+	size_t keyTotal = leftPage.keys.size();
+
+	// Split where the keys before reach half of the key bytes, leaving at least one key on each
+	// side, and for an inner page one more for the middle key that moves up
+	size_t keyBytes = 0;
+	for (const string& key : leftPage.keys)
+	{
+		keyBytes += 2 + key.size();
+	}
+	size_t splitIndex = 0;
+	for (size_t leftBytes = 0; splitIndex < keyTotal && leftBytes < keyBytes / 2; splitIndex++)
+	{
+		leftBytes += 2 + leftPage.keys[splitIndex].size();
+	}
+	size_t lastSplit = leftPage.isLeaf ? keyTotal - 1 : keyTotal - 2;
+	splitIndex = min(max(splitIndex, static_cast<size_t>(1)), lastSplit);
+
+	if (leftPage.isLeaf)
+	{
+		rightPage.keys.assign(make_move_iterator(leftPage.keys.begin() + splitIndex), make_move_iterator(leftPage.keys.end()));
+		leftPage.keys.resize(splitIndex);
+		separatorKey = rightPage.keys.front();
+		rightPage.nextLeaf = leftPage.nextLeaf;
+		leftPage.nextLeaf = rightPageId;
+	}
+	else
+	{
+		separatorKey = std::move(leftPage.keys[splitIndex]);
+		rightPage.keys.assign(make_move_iterator(leftPage.keys.begin() + splitIndex + 1), make_move_iterator(leftPage.keys.end()));
+		rightPage.children.assign(leftPage.children.begin() + splitIndex + 1, leftPage.children.end());
+		leftPage.keys.resize(splitIndex);
+		leftPage.children.resize(splitIndex + 1);
+	}
+
+	unpinPage(rightPageId);
+	unpinPage(pageId);
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[findLeaf]--------------------------------------------
+// Description: The findLeaf method walks from the root to the leaf that key belongs in, at
+// each inner page taking the child after the last separator that is not greater than key,
+// and adds each inner page to pagePath if one is given. It returns false if a page above
+// the leaf level cannot be read or is not an inner page with a child for key that is in the
+// file, as a damaged file (or a wrong height in its header) could give.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::findLeaf(string_view key, uint32_t &leafPageId, vector<uint32_t>* pagePath) const
+{
+	uint32_t pageId = rootPage;
+	for (uint32_t level = 1; level < treeHeight; level++)
+	{
+		if (pagePath != nullptr)
+		{
+			pagePath->push_back(pageId);
+		}
+		const DecodedPage* innerPage = pinPage(pageId, false);
+		if (innerPage == nullptr)
+		{
+			return false;
+		}
+		size_t childIndex = upper_bound(innerPage->keys.begin(), innerPage->keys.end(), key) - innerPage->keys.begin();
+		uint32_t childId = NULL_PAGE;
+		if (!innerPage->isLeaf && childIndex < innerPage->children.size())
+		{
+			childId = innerPage->children[childIndex];
+		}
+		unpinPage(pageId);
+		if (childId == NULL_PAGE || childId >= pageCount)
+		{
+			ioError = true;
+			return false;
+		}
+		pageId = childId;
+	}
+	leafPageId = pageId;
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[retrieve]---------------------------------------------
+// Description: The retrieve methods find the leaf targetNodeData belongs in and binary
+// search its keys, the second version sets retrievedNodeData to the stored key when it is
+// found. Both return false when no file is open or a page on the way cannot be read.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::retrieve(const NodeData &targetNodeData) const
+{
+	NodeData retrievedNodeData;
+	return retrieve(targetNodeData, retrievedNodeData);
+}
+
+bool PagedBinTree::retrieve(const NodeData &targetNodeData, NodeData &retrievedNodeData) const
+{
+	if (!fileOpen)
+	{
+		return false;
+	}
+
+	const string& targetKey = targetNodeData.getData();
+	uint32_t leafId;
+	if (!findLeaf(targetKey, leafId))
+	{
+		return false;
+	}
+	const DecodedPage* leafPage = pinLeaf(leafId);
+	if (leafPage == nullptr)
+	{
+		return false;
+	}
+	vector<string>::const_iterator found = lower_bound(leafPage->keys.begin(), leafPage->keys.end(), targetKey);
+	bool isFound = found != leafPage->keys.end() && *found == targetKey;
+	if (isFound)
+	{
+		retrievedNodeData = NodeData(*found);
+	}
+	unpinPage(leafId);
+	return isFound;
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------------[pinPage]--------------------------------------------
+// Description: The pinPage method returns the decoded page pageId, reading it from the file
+// into a free or evicted frame if it is not cached, and counts the hit or miss. The page
+// stays in the cache until it is unpinned, so the pointer stays valid until then. A page
+// number outside the file, a page the file cannot give back (a damaged or cut off file), or
+// no frame to put it in gives nullptr and sets the error flag, and the frame is left free.
+// pinLeaf does the same and also fails for a page that is not a leaf.
+// -------------------------------------------------------------------------------------------
+PagedBinTree::DecodedPage* PagedBinTree::pinPage(uint32_t pageId, bool forWrite) const
+{
+	unordered_map<uint32_t, size_t>::iterator cached = frameOfPage.find(pageId);
+	if (cached != frameOfPage.end())
+	{
+		Frame& frame = frames[cached->second];
+		counters.hits++;
+		frame.referenced = true;
+		frame.dirty = frame.dirty || forWrite;
+		frame.pinCount++;
+		return &frame.page;
+	}
+
+	size_t frameIndex;
+	if (pageId == NULL_PAGE || pageId >= pageCount || !takeFrame(frameIndex))
+	{
+		ioError = true;
+		return nullptr;
+	}
+	counters.misses++;
+	Frame& frame = frames[frameIndex];
+
+	char pageBytes[PAGE_SIZE];
+	file.seekg(static_cast<streamoff>(pageId) * PAGE_SIZE);
+	file.read(pageBytes, PAGE_SIZE);
+	counters.bytesRead += static_cast<unsigned long long>(file.gcount());
+	if (!file || !decodePage(pageBytes, frame.page))
+	{
+		// The frame holds no page, and being unpinned and unreferenced it is the next one taken
+		file.clear();
+		frame.pageId = NULL_PAGE;
+		frame.referenced = false;
+		frame.dirty = false;
+		frame.pinCount = 0;
+		ioError = true;
+		return nullptr;
+	}
+
+	frame.pageId = pageId;
+	frame.referenced = true;
+	frame.dirty = forWrite;
+	frame.pinCount = 1;
+	frameOfPage[pageId] = frameIndex;
+	return &frame.page;
+}
+
+PagedBinTree::DecodedPage* PagedBinTree::pinLeaf(uint32_t pageId) const
+{
+	DecodedPage* leafPage = pinPage(pageId, false);
+	if (leafPage != nullptr && !leafPage->isLeaf)
+	{
+		unpinPage(pageId);
+		ioError = true;
+		return nullptr;
+	}
+	return leafPage;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[unpinPage]-------------------------------------------
+// Description: The unpinPage method releases one pin of pageId, a page with no pins left may
+// be evicted. markDirty marks a pinned page as changed, so it is written before it leaves.
+// -------------------------------------------------------------------------------------------
+void PagedBinTree::unpinPage(uint32_t pageId) const
+{
+	frames[frameOfPage.at(pageId)].pinCount--;
+}
+
+void PagedBinTree::markDirty(uint32_t pageId)
+{
+	frames[frameOfPage.at(pageId)].dirty = true;
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------------[newPage]--------------------------------------------
+// Description: The newPage method gives out the next page number at the end of the file and
+// puts an empty page for it in the cache, pinned and dirty. The page reaches the file the
+// first time it is evicted or flushed. It returns nullptr if no frame can be freed for it.
+// -------------------------------------------------------------------------------------------
+PagedBinTree::DecodedPage* PagedBinTree::newPage(bool isLeaf, uint32_t &pageId)
+{
+	size_t frameIndex;
+	if (!takeFrame(frameIndex))
+	{
+		return nullptr;
+	}
+	pageId = pageCount++;
+	Frame& frame = frames[frameIndex];
+	frame.pageId = pageId;
+	frame.referenced = true;
+	frame.dirty = true;
+	frame.pinCount = 1;
+	frame.page = DecodedPage{ isLeaf, {}, {}, NULL_PAGE };
+	if (!isLeaf)
+	{
+		frame.page.children.reserve(2);
+	}
+	frameOfPage[pageId] = frameIndex;
+	return &frame.page;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[takeFrame]-------------------------------------------
+// Description: The takeFrame method sets frameIndex to a frame to load a page into. While
+// the cache is not full that is a new frame, after that the CLOCK hand sweeps the frames,
+// clearing the referenced bit of each unpinned frame it passes, and evicts the first
+// unpinned frame whose bit was already clear, writing it back first if it is dirty. At most
+// two pages are pinned at once and the cache has at least MIN_CACHE_PAGES frames, so the
+// sweep always ends. It returns false if the page to evict cannot be written back, which
+// leaves that page in the cache.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::takeFrame(size_t &frameIndex) const
+{
+	// The frames are reserved up front, so adding one never moves the others
+	if (frames.size() < cacheCapacity)
+	{
+		frames.emplace_back();
+		frameIndex = frames.size() - 1;
+		return true;
+	}
+
+	while (true)
+	{
+		frameIndex = clockHand;
+		clockHand = (clockHand + 1) % frames.size();
+		Frame& frame = frames[frameIndex];
+		if (frame.pinCount > 0)
+		{
+			continue;
+		}
+		if (frame.referenced)
+		{
+			frame.referenced = false;
+			continue;
+		}
+
+		if (frame.dirty && !writeFrame(frame))
+		{
+			return false;
+		}
+		frameOfPage.erase(frame.pageId);
+		counters.evictions++;
+		return true;
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[writeFrame]-------------------------------------------
+// Description: The writeFrame method encodes the page in frame and writes it to its place in
+// the file, after which the frame is clean. It returns false and sets the error flag if the
+// write fails, or if the page is too big to encode (a split that was never finished), and
+// the frame then stays dirty.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::writeFrame(Frame& frame) const
+{
+	if (encodedSize(frame.page) > PAGE_SIZE)
+	{
+		ioError = true;
+		return false;
+	}
+
+	char pageBytes[PAGE_SIZE];
+	encodePage(frame.page, pageBytes);
+	file.seekp(static_cast<streamoff>(frame.pageId) * PAGE_SIZE);
+	if (!file.write(pageBytes, PAGE_SIZE))
+	{
+		file.clear();
+		ioError = true;
+		return false;
+	}
+	counters.bytesWritten += PAGE_SIZE;
+	frame.dirty = false;
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[encodedSize]------------------------------------------
+// Description: The encodedSize method returns the number of bytes page takes in the file, a
+// page is split as soon as this is more than PAGE_SIZE.
+// -------------------------------------------------------------------------------------------
+size_t PagedBinTree::encodedSize(const DecodedPage& page)
+{
+	size_t pageBytes = PAGE_HEADER_BYTES + page.children.size() * sizeof(uint32_t);
+	for (const string& key : page.keys)
+	{
+		pageBytes += sizeof(uint16_t) + key.size();
+	}
+	return pageBytes;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[encodePage]-------------------------------------------
+// Description: The encodePage method writes page into the PAGE_SIZE bytes of pageBytes in
+// the layout described at the top of this file, the unused end of the page is zeroed.
+// -------------------------------------------------------------------------------------------
+void PagedBinTree::encodePage(const DecodedPage& page, char* pageBytes)
+{
+	memset(pageBytes, 0, PAGE_SIZE);
+	uint8_t isLeaf = page.isLeaf ? 1 : 0;
+	uint16_t pageKeyCount = static_cast<uint16_t>(page.keys.size());
+	memcpy(pageBytes, &isLeaf, sizeof(isLeaf));
+	memcpy(pageBytes + 2, &pageKeyCount, sizeof(pageKeyCount));
+	memcpy(pageBytes + 4, &page.nextLeaf, sizeof(page.nextLeaf));
+
+	char* position = pageBytes + PAGE_HEADER_BYTES;
+	for (uint32_t childId : page.children)
+	{
+		memcpy(position, &childId, sizeof(childId));
+		position += sizeof(childId);
+	}
+	for (const string& key : page.keys)
+	{
+		uint16_t keyLength = static_cast<uint16_t>(key.size());
+		memcpy(position, &keyLength, sizeof(keyLength));
+		memcpy(position + sizeof(keyLength), key.data(), key.size());
+		position += sizeof(keyLength) + key.size();
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[decodePage]-------------------------------------------
+// Description: The decodePage method reads the page in pageBytes into page, and returns false
+// if a count or length would run past the end of the page.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::decodePage(const char* pageBytes, DecodedPage& page)
+{
+	uint8_t isLeaf;
+	uint16_t pageKeyCount;
+	memcpy(&isLeaf, pageBytes, sizeof(isLeaf));
+	memcpy(&pageKeyCount, pageBytes + 2, sizeof(pageKeyCount));
+	memcpy(&page.nextLeaf, pageBytes + 4, sizeof(page.nextLeaf));
+	page.isLeaf = (isLeaf != 0);
+
+	const char* position = pageBytes + PAGE_HEADER_BYTES;
+	const char* pageEnd = pageBytes + PAGE_SIZE;
+	size_t childTotal = page.isLeaf ? 0 : static_cast<size_t>(pageKeyCount) + 1;
+	if (childTotal * sizeof(uint32_t) > static_cast<size_t>(pageEnd - position))
+	{
+		return false;
+	}
+	page.children.resize(childTotal);
+	if (childTotal > 0)
+	{
+		memcpy(page.children.data(), position, childTotal * sizeof(uint32_t));
+		position += childTotal * sizeof(uint32_t);
+	}
+
+	page.keys.resize(pageKeyCount);
+	for (string& key : page.keys)
+	{
+		uint16_t keyLength;
+		if (pageEnd - position < static_cast<ptrdiff_t>(sizeof(keyLength)))
+		{
+			return false;
+		}
+		memcpy(&keyLength, position, sizeof(keyLength));
+		position += sizeof(keyLength);
+		if (pageEnd - position < static_cast<ptrdiff_t>(keyLength))
+		{
+			return false;
+		}
+		key.assign(position, keyLength);
+		position += keyLength;
+	}
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[writeHeader]------------------------------------------
+// Description: The writeHeader method writes the magic value, page size, page count, root
+// page, height and key count into page 0, and returns false if the write fails. readHeader
+// reads them back, and returns false if the file is too short or was not written by this
+// class with the same page size.
+// -------------------------------------------------------------------------------------------
+bool PagedBinTree::writeHeader()
+{
+	char pageBytes[PAGE_SIZE];
+	memset(pageBytes, 0, PAGE_SIZE);
+	uint32_t pageSize = PAGE_SIZE;
+	memcpy(pageBytes, PAGED_TREE_MAGIC, sizeof(PAGED_TREE_MAGIC));
+	memcpy(pageBytes + 4, &pageSize, sizeof(pageSize));
+	memcpy(pageBytes + 8, &pageCount, sizeof(pageCount));
+	memcpy(pageBytes + 12, &rootPage, sizeof(rootPage));
+	memcpy(pageBytes + 16, &treeHeight, sizeof(treeHeight));
+	memcpy(pageBytes + 24, &keyCount, sizeof(keyCount));
+
+	file.seekp(0);
+	if (!file.write(pageBytes, PAGE_SIZE))
+	{
+		file.clear();
+		ioError = true;
+		return false;
+	}
+	counters.bytesWritten += PAGE_SIZE;
+	return true;
+}
+
+bool PagedBinTree::readHeader()
+{
+	char pageBytes[PAGE_SIZE];
+	file.seekg(0);
+	file.read(pageBytes, PAGE_SIZE);
+	if (!file)
+	{
+		return false;
+	}
+
+	uint32_t pageSize;
+	memcpy(&pageSize, pageBytes + 4, sizeof(pageSize));
+	if (memcmp(pageBytes, PAGED_TREE_MAGIC, sizeof(PAGED_TREE_MAGIC)) != 0 || pageSize != PAGE_SIZE)
+	{
+		return false;
+	}
+	memcpy(&pageCount, pageBytes + 8, sizeof(pageCount));
+	memcpy(&rootPage, pageBytes + 12, sizeof(rootPage));
+	memcpy(&treeHeight, pageBytes + 16, sizeof(treeHeight));
+	memcpy(&keyCount, pageBytes + 24, sizeof(keyCount));
+	return rootPage != NULL_PAGE && rootPage < pageCount && treeHeight > 0;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------------[stats]---------------------------------------------
+// Description: The stats method returns a copy of the page cache counters, and resetStats
+// sets them back to 0, for example after warming the cache up.
+// -------------------------------------------------------------------------------------------
+PageCacheStats PagedBinTree::stats() const
+{
+	return counters;
+}
+
+void PagedBinTree::resetStats()
+{
+	counters = PageCacheStats();
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[InorderCursor]-------------------------------------------
+// Description: The InorderCursor constructor finds the leaf startKey belongs in and the
+// first key there that is not less than it. settle moves along the leaf chain past leaves
+// that are used up (or empty) and copies the key the cursor lands on, so no page stays
+// pinned between calls. A tree with no open file gives a cursor that is already done. A
+// leaf that cannot be read, or a chain longer than the file has pages (a loop in a damaged
+// file), ends the walk there.
+// -------------------------------------------------------------------------------------------
+PagedBinTree::InorderCursor::InorderCursor(const PagedBinTree &pagedTree, string_view startKey)
+{
+	tree = &pagedTree;
+	leafPageId = NULL_PAGE;
+	leavesLeft = tree->pageCount;
+	keyIndex = 0;
+	if (!tree->fileOpen || !tree->findLeaf(startKey, leafPageId))
+	{
+		leafPageId = NULL_PAGE;
+		return;
+	}
+
+	const DecodedPage* leafPage = tree->pinLeaf(leafPageId);
+	if (leafPage == nullptr)
+	{
+		leafPageId = NULL_PAGE;
+		return;
+	}
+	keyIndex = lower_bound(leafPage->keys.begin(), leafPage->keys.end(), startKey) - leafPage->keys.begin();
+	tree->unpinPage(leafPageId);
+	settle();
+}
+
+void PagedBinTree::InorderCursor::settle()
+{
+	while (leafPageId != NULL_PAGE)
+	{
+		const DecodedPage* leafPage = (leavesLeft > 0) ? tree->pinLeaf(leafPageId) : nullptr;
+		if (leafPage == nullptr)
+		{
+			tree->ioError = true;
+			leafPageId = NULL_PAGE;
+			return;
+		}
+		if (keyIndex < leafPage->keys.size())
+		{
+			currentKey = leafPage->keys[keyIndex];
+			tree->unpinPage(leafPageId);
+			return;
+		}
+		uint32_t nextLeafId = leafPage->nextLeaf;
+		tree->unpinPage(leafPageId);
+		leafPageId = nextLeafId;
+		leavesLeft--;
+		keyIndex = 0;
+	}
+}
+
+bool PagedBinTree::InorderCursor::isDone() const
+{
+	return leafPageId == NULL_PAGE;
+}
+
+const string& PagedBinTree::InorderCursor::current() const
+{
+	return currentKey;
+}
+
+void PagedBinTree::InorderCursor::advance()
+{
+	keyIndex++;
+	settle();
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[operator<<]-------------------------------------------
+// Description: The overloaded output operator prints every key in sorted order by walking the
+// leaf chain, the same output a BinTree with the same keys would give.
+// -------------------------------------------------------------------------------------------
+ostream& operator<<(ostream& out, const PagedBinTree &pagedTree)
+{
+	for (PagedBinTree::InorderCursor cursor(pagedTree); !cursor.isDone(); cursor.advance())
+	{
+		out << cursor.current() << " ";
+	}
+	out << endl;
+	return out;
+}
+// -------------------------------------------------------------------------------------------
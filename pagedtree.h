@@ -0,0 +1,202 @@
+// ----------------------------- pagedtree.h ---------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The pagedtree.h file is the header file for the PagedBinTree
+// class, an out-of-core mode of the binary search tree for key sets that
+// do not fit in memory. It has the insert, retrieve, ordered output and
+// in order cursor interface of the other trees, but keeps its keys in a
+// file of fixed size pages and only a bounded number of pages in memory.
+// ---------------------------------------------------------------------
+// Notes - The file is laid out as a B+-tree. Page 0 is a header, every
+// other page is one node, inner nodes hold separator keys and the page
+// numbers of their children, and leaves hold the keys themselves and the
+// page number of the next leaf, so an ordered scan just follows the leaf
+// chain. Pages are kept in a cache of decoded pages with a fixed number of
+// frames, replaced with the CLOCK algorithm, and a changed page is only
+// written back when it is evicted or the tree is flushed. The cache counts
+// its hits, misses, evictions and the bytes it reads and writes. A page
+// holds about 4 KB, so a lookup reads only a handful of pages, and with a
+// warm cache it is a few binary searches over short arrays of keys. Keys
+// longer than MAX_KEY_BYTES are rejected, so that every page can hold at
+// least a few keys. Numbers in the file are in the machine's byte order.
+// ---------------------------------------------------------------------
+#ifndef PAGED_TREE_H
+#define PAGED_TREE_H
+#include "nodedata.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// The PageCacheStats struct is a snapshot of the page cache counters of one PagedBinTree
+struct PageCacheStats {
+    unsigned long long hits;            // page requests served from the cache
+    unsigned long long misses;          // page requests that had to read the file
+    unsigned long long evictions;       // pages dropped from the cache to make room
+    unsigned long long bytesRead;       // bytes read from the file
+    unsigned long long bytesWritten;    // bytes written to the file
+};
+
+class PagedBinTree {
+
+    public:
+        // Size of every page in the file, and the longest key the tree accepts
+        static const size_t PAGE_SIZE = 4096;
+        static const size_t MAX_KEY_BYTES = 1000;
+
+        // Cache size used when none is given, and the smallest cache the tree will use
+        static const size_t DEFAULT_CACHE_PAGES = 1024;
+        static const size_t MIN_CACHE_PAGES = 4;
+
+    private:
+        // Page number meaning "no page", used for the end of the leaf chain
+        static const uint32_t NULL_PAGE = 0;
+
+        // The DecodedPage struct is one node of the tree as it is kept in the cache. A leaf
+        // has its sorted keys and the next leaf, an inner node has its sorted separator keys
+        // and one more child than keys, child i holding the keys from keys[i - 1] (inclusive)
+        // up to keys[i] (exclusive)
+        struct DecodedPage {
+            bool isLeaf;
+            vector<string> keys;
+            vector<uint32_t> children;
+            uint32_t nextLeaf;
+        };
+
+        // The Frame struct is one cache slot, referenced is the CLOCK bit, a dirty page differs
+        // from the file, and a pinned page is in use and may not be evicted
+        struct Frame {
+            uint32_t pageId;
+            bool referenced;
+            bool dirty;
+            int pinCount;
+            DecodedPage page;
+        };
+
+        // The open file and its header fields
+        mutable fstream file;
+        bool fileOpen;
+        uint32_t pageCount;
+        uint32_t rootPage;
+        uint32_t treeHeight;
+        uint64_t keyCount;
+
+        // The page cache, a map from page number to frame, and the CLOCK hand
+        mutable vector<Frame> frames;
+        mutable unordered_map<uint32_t, size_t> frameOfPage;
+        mutable size_t clockHand;
+        size_t cacheCapacity;
+        mutable PageCacheStats counters;
+
+        // Set when a page could not be read, decoded or written, until the next create or open
+        mutable bool ioError;
+
+    // Helper methods for the page cache, pinPage loads a page if needed and keeps it in the
+    // cache until unpinPage, pinLeaf also checks that the page is a leaf, markDirty notes that
+    // a pinned page was changed, and newPage adds a fresh empty page that is pinned and dirty.
+    // The methods that give out a page return nullptr when it cannot be had
+    DecodedPage* pinPage(uint32_t pageId, bool forWrite) const;
+    DecodedPage* pinLeaf(uint32_t pageId) const;
+    void unpinPage(uint32_t pageId) const;
+    void markDirty(uint32_t pageId);
+    DecodedPage* newPage(bool isLeaf, uint32_t &pageId);
+    bool takeFrame(size_t &frameIndex) const;
+    bool writeFrame(Frame& frame) const;
+
+    // Helper methods that convert between a decoded page and its bytes in the file
+    static size_t encodedSize(const DecodedPage& page);
+    static void encodePage(const DecodedPage& page, char* pageBytes);
+    static bool decodePage(const char* pageBytes, DecodedPage& page);
+
+    // Helper methods for the header page, and for splitting a page that no longer fits
+    bool writeHeader();
+    bool readHeader();
+    bool splitPage(uint32_t pageId, string& separatorKey, uint32_t& rightPageId);
+
+    // Helper method that finds the leaf that key belongs in, optionally noting the inner pages
+    // on the way, and returns false if a page on the way is missing or not a valid inner page
+    bool findLeaf(string_view key, uint32_t &leafPageId, vector<uint32_t>* pagePath = nullptr) const;
+
+    public:
+        // The InorderCursor class walks the keys in sorted order along the leaf chain, the
+        // tree must not change while a cursor is walking it. A page that cannot be read ends
+        // the walk early and sets the tree's error flag
+        class InorderCursor {
+
+            private:
+                const PagedBinTree* tree;
+                uint32_t leafPageId;
+                uint32_t leavesLeft;
+                size_t keyIndex;
+                string currentKey;
+
+            // Helper method that moves to the next leaf while the current one is used up
+            void settle();
+
+            public:
+                // Starts a cursor at the smallest key not less than startKey
+                explicit InorderCursor(const PagedBinTree &pagedTree, string_view startKey = string_view());
+
+                // isDone is true after the last key, current is the key the cursor is at
+                bool isDone() const;
+                const string& current() const;
+
+                // Moves the cursor to the next larger key
+                void advance();
+        };
+
+        // Paged tree constructor and destructor, the destructor flushes and closes the file
+        PagedBinTree();
+        ~PagedBinTree();
+
+        // The tree owns an open file, so it is not copied
+        PagedBinTree(const PagedBinTree &otherPagedTree) = delete;
+        PagedBinTree& operator=(const PagedBinTree &otherPagedTree) = delete;
+
+        // create starts a new empty tree in fileName, replacing the file, open loads a tree
+        // saved there before, both return false if the file cannot be used
+        bool create(const string& fileName, size_t cachePages = DEFAULT_CACHE_PAGES);
+        bool open(const string& fileName, size_t cachePages = DEFAULT_CACHE_PAGES);
+
+        // flush writes every changed page and the header to the file, close also closes it,
+        // and both return false if a write failed
+        bool flush();
+        bool close();
+        bool isOpen() const;
+
+        // hasError is true once a page could not be read, decoded or written since the last
+        // create or open, the file may then be damaged and insert refuses new keys
+        bool hasError() const;
+
+        // isEmpty checks whether there are any keys, size counts them, getHeight returns the
+        // number of levels of pages (an empty tree is one empty leaf)
+        bool isEmpty() const;
+        uint64_t size() const;
+        int getHeight() const;
+
+        // Insert copies the key of newNodeData into the tree, it returns false for a duplicate,
+        // a key longer than MAX_KEY_BYTES, when no file is open, or after an error
+        bool insert(const NodeData &newNodeData);
+
+        // Retrieve checks for targetNodeData, the second version also copies the stored key out,
+        // both return false if a page on the way cannot be read (and set hasError)
+        bool retrieve(const NodeData &targetNodeData) const;
+        bool retrieve(const NodeData &targetNodeData, NodeData &retrievedNodeData) const;
+
+        // stats returns a snapshot of the page cache counters, resetStats sets them back to 0
+        PageCacheStats stats() const;
+        void resetStats();
+
+        // Prints every key in sorted order, followed by a new line
+        friend ostream& operator<<(ostream& out, const PagedBinTree &pagedTree);
+};
+
+#endif
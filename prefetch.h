@@ -0,0 +1,26 @@
+// ----------------------------- prefetch.h ----------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The prefetch.h file defines the PREFETCH_READ macro that the
+// tree classes use to ask the processor to start loading memory that a
+// search is about to read, so that cache misses can overlap, and the
+// UNLIKELY macro that marks a branch the search almost never takes.
+// ---------------------------------------------------------------------
+// Notes - PREFETCH_READ and UNLIKELY are only hints, PREFETCH_READ never
+// faults, and both compile to nothing on compilers without the builtins.
+// ---------------------------------------------------------------------
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH_READ(address) __builtin_prefetch(address)
+#define UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#else
+#define PREFETCH_READ(address) ((void)(address))
+#define UNLIKELY(condition) (condition)
+#endif
+
+#endif
@@ -0,0 +1,342 @@
+// --------------------------- shardedtree.cpp -------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The shardedtree.cpp file is the implementation file for the
+// ShardedBinTree class, it routes each key to its shard, does the shard's
+// BinTree operation under the shard's lock, and merges the shards back
+// into one sorted order for output.
+// ---------------------------------------------------------------------
+// Notes - Hash partitioning spreads any key distribution evenly over the
+// shards, range partitioning keeps neighbouring keys together so a shard
+// can be handed to the thread that produces that part of the key space.
+// The output operator takes the shard locks in index order, and no other
+// method holds more than one lock at a time, so locking cannot deadlock.
+// ---------------------------------------------------------------------
+#include "shardedtree.h"
+#include <algorithm>
+#include <functional>
+using namespace std;
+
+// ----------------------------[Hash Partition Constructor]-----------------------------------
+// Description: This constructor builds an empty sharded tree with shardCount hash
+// partitioned shards, a count below 1 is treated as 1.
+// -------------------------------------------------------------------------------------------
+ShardedBinTree::ShardedBinTree(int shardCount)
+{
+	this->shardCount = (shardCount > 0) ? shardCount : 1;
+	partitionMode = HASH_PARTITION;
+	shards.reset(new Shard[this->shardCount]);
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------[Range Partition Constructor]-----------------------------------
+// Description: This constructor builds an empty range partitioned sharded tree. The bounds
+// are sorted and duplicates dropped, and there is one shard below the first bound, one
+// between each pair of neighbouring bounds, and one from the last bound up.
+// -------------------------------------------------------------------------------------------
+ShardedBinTree::ShardedBinTree(vector<string> rangeBounds)
+{
+	sort(rangeBounds.begin(), rangeBounds.end());
+	rangeBounds.erase(unique(rangeBounds.begin(), rangeBounds.end()), rangeBounds.end());
+	this->rangeBounds = std::move(rangeBounds);
+
+	shardCount = static_cast<int>(this->rangeBounds.size()) + 1;
+	partitionMode = RANGE_PARTITION;
+	shards.reset(new Shard[shardCount]);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[hashKey]---------------------------------------------
+// Description: The hashKey method returns the hash of key used for hash partitioning, a
+// caller that already has it can pass it to the precomputed hash overloads.
+// -------------------------------------------------------------------------------------------
+size_t ShardedBinTree::hashKey(string_view key)
+{
+	return hash<string_view>()(key);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[getShardCount]---------------------------------------------
+// Description: The getShardCount, getPartitionMode and shardOf methods return the number of
+// shards, how keys are assigned to them, and the index of the shard that key belongs to.
+// -------------------------------------------------------------------------------------------
+int ShardedBinTree::getShardCount() const
+{
+	return shardCount;
+}
+
+ShardedBinTree::PartitionMode ShardedBinTree::getPartitionMode() const
+{
+	return partitionMode;
+}
+
+int ShardedBinTree::shardOf(string_view key) const
+{
+	return shardOfKey(key);
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[shardOfKey]---------------------------------------------
+// Description: The shardOfKey method returns the shard that key belongs to. Under range
+// partitioning that is the number of bounds that are not greater than key, found with a
+// binary search, otherwise it is picked by the key's hash.
+// -------------------------------------------------------------------------------------------
+int ShardedBinTree::shardOfKey(string_view key) const
+{
+	if (partitionMode == RANGE_PARTITION)
+	{
+		return static_cast<int>(upper_bound(rangeBounds.begin(), rangeBounds.end(), key,
+			[](string_view targetKey, const string& bound) { return targetKey < bound; }) - rangeBounds.begin());
+	}
+	return shardOfHash(key, hashKey(key));
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[shardOfHash]--------------------------------------------
+// Description: The shardOfHash method returns the shard that key belongs to given its
+// precomputed hash, which is only used under hash partitioning.
+// -------------------------------------------------------------------------------------------
+int ShardedBinTree::shardOfHash(string_view key, size_t keyHash) const
+{
+	if (partitionMode == RANGE_PARTITION)
+	{
+		return shardOfKey(key);
+	}
+	return static_cast<int>(keyHash % static_cast<size_t>(shardCount));
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[insert]----------------------------------------------
+// Description: The insert methods insert newNodeData into its shard while holding that
+// shard's lock, and count the new key. As with BinTree::insert, the tree takes ownership of
+// newNodeData only when true is returned.
+// -------------------------------------------------------------------------------------------
+bool ShardedBinTree::insert(NodeData* newNodeData)
+{
+	Shard& shard = shards[shardOfKey(newNodeData->getData())];
+	lock_guard<mutex> shardGuard(shard.lock);
+	if (!shard.tree.insert(newNodeData))
+	{
+		return false;
+	}
+	shard.keyCount++;
+	return true;
+}
+
+bool ShardedBinTree::insert(NodeData* newNodeData, size_t keyHash)
+{
+	Shard& shard = shards[shardOfHash(newNodeData->getData(), keyHash)];
+	lock_guard<mutex> shardGuard(shard.lock);
+	if (!shard.tree.insert(newNodeData))
+	{
+		return false;
+	}
+	shard.keyCount++;
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[emplace]---------------------------------------------
+// Description: The emplace methods insert key into its shard while holding that shard's
+// lock, and count the new key. The NodeData is only allocated if the key is not already there.
+// -------------------------------------------------------------------------------------------
+bool ShardedBinTree::emplace(string_view key)
+{
+	Shard& shard = shards[shardOfKey(key)];
+	lock_guard<mutex> shardGuard(shard.lock);
+	if (!shard.tree.emplace(key))
+	{
+		return false;
+	}
+	shard.keyCount++;
+	return true;
+}
+
+bool ShardedBinTree::emplace(string_view key, size_t keyHash)
+{
+	Shard& shard = shards[shardOfHash(key, keyHash)];
+	lock_guard<mutex> shardGuard(shard.lock);
+	if (!shard.tree.emplace(key))
+	{
+		return false;
+	}
+	shard.keyCount++;
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[retrieve]---------------------------------------------
+// Description: The retrieve methods look the target up in its shard while holding that
+// shard's lock, and set retrievedNodeData to the stored node data or nullptr.
+// -------------------------------------------------------------------------------------------
+bool ShardedBinTree::retrieve(const NodeData &targetNodeData, NodeData* &retrievedNodeData)
+{
+	return retrieveByKey(targetNodeData.getData(), retrievedNodeData);
+}
+
+bool ShardedBinTree::retrieveByKey(string_view targetKey, NodeData* &retrievedNodeData)
+{
+	Shard& shard = shards[shardOfKey(targetKey)];
+	lock_guard<mutex> shardGuard(shard.lock);
+	return shard.tree.retrieve(targetKey, retrievedNodeData);
+}
+
+bool ShardedBinTree::retrieve(string_view targetKey, size_t keyHash, NodeData* &retrievedNodeData)
+{
+	Shard& shard = shards[shardOfHash(targetKey, keyHash)];
+	lock_guard<mutex> shardGuard(shard.lock);
+	return shard.tree.retrieve(targetKey, retrievedNodeData);
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------------[erase]----------------------------------------------
+// Description: The erase method removes targetKey from its shard while holding that shard's
+// lock, and takes it off the count. It returns false if the key was not there.
+// -------------------------------------------------------------------------------------------
+bool ShardedBinTree::erase(string_view targetKey)
+{
+	Shard& shard = shards[shardOfKey(targetKey)];
+	lock_guard<mutex> shardGuard(shard.lock);
+	if (!shard.tree.erase(targetKey))
+	{
+		return false;
+	}
+	shard.keyCount--;
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[makeEmpty]--------------------------------------------
+// Description: The makeEmpty method deletes every key of every shard, isEmpty returns true
+// if no shard has a key, and size returns the number of keys in all of the shards. size
+// adds up the shards' key counts, reading each under its lock, and only walks the tree of a
+// shard that was handed out by shardTree, whose count is not kept.
+// -------------------------------------------------------------------------------------------
+void ShardedBinTree::makeEmpty()
+{
+	for (int shardIndex = 0; shardIndex < shardCount; shardIndex++)
+	{
+		shards[shardIndex].tree.makeEmpty();
+		shards[shardIndex].keyCount = 0;
+		shards[shardIndex].keyCountKnown = true;
+	}
+}
+
+bool ShardedBinTree::isEmpty() const
+{
+	for (int shardIndex = 0; shardIndex < shardCount; shardIndex++)
+	{
+		if (!shards[shardIndex].tree.isEmpty())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int ShardedBinTree::size() const
+{
+	int keyCount = 0;
+	for (int shardIndex = 0; shardIndex < shardCount; shardIndex++)
+	{
+		const Shard& shard = shards[shardIndex];
+		lock_guard<mutex> shardGuard(shard.lock);
+		keyCount += shard.keyCountKnown ? shard.keyCount : shard.tree.shapeStats().nodeCount;
+	}
+	return keyCount;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[shardTree]--------------------------------------------
+// Description: The shardTree method returns the tree of one shard without locking it, for a
+// thread that owns the shard or for single threaded use. The caller must keep every key it
+// inserts in the shard that shardOf gives for it. The shard's key count cannot follow changes
+// made through the returned tree, so it is dropped until the next makeEmpty.
+// -------------------------------------------------------------------------------------------
+BinTree& ShardedBinTree::shardTree(int shardIndex)
+{
+	Shard& shard = shards[shardIndex];
+	lock_guard<mutex> shardGuard(shard.lock);
+	shard.keyCountKnown = false;
+	return shard.tree;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[OrderedCursor]-------------------------------------------
+// Description: The OrderedCursor constructor starts an inorder cursor on every shard and
+// puts the smallest key of each nonempty shard in the merge heap. Each advance pops the
+// smallest key, moves its shard's cursor on, and pushes that shard's next key, so a full
+// walk of n keys in k shards takes O(n log k) time. Shards never share a key, so there are
+// no ties to break.
+// -------------------------------------------------------------------------------------------
+ShardedBinTree::OrderedCursor::OrderedCursor(const ShardedBinTree &shardedTree)
+{
+	shardCursors.reserve(shardedTree.shardCount);
+	for (int shardIndex = 0; shardIndex < shardedTree.shardCount; shardIndex++)
+	{
+		shardCursors.emplace_back(shardedTree.shards[shardIndex].tree);
+		if (!shardCursors.back().isDone())
+		{
+			mergeHeap.push_back({shardCursors.back().current(), shardIndex});
+		}
+	}
+	make_heap(mergeHeap.begin(), mergeHeap.end(), comesAfter);
+}
+
+bool ShardedBinTree::OrderedCursor::comesAfter(const HeapEntry &firstEntry, const HeapEntry &secondEntry)
+{
+	return *secondEntry.data < *firstEntry.data;
+}
+
+bool ShardedBinTree::OrderedCursor::isDone() const
+{
+	return mergeHeap.empty();
+}
+
+NodeData* ShardedBinTree::OrderedCursor::current() const
+{
+	return mergeHeap.front().data;
+}
+
+void ShardedBinTree::OrderedCursor::advance()
+{
+	pop_heap(mergeHeap.begin(), mergeHeap.end(), comesAfter);
+	BinTree::InorderCursor& shardCursor = shardCursors[mergeHeap.back().shardIndex];
+	shardCursor.advance();
+
+	// The shard's next key takes its old entry, or the entry goes if the shard is done
+	if (shardCursor.isDone())
+	{
+		mergeHeap.pop_back();
+		return;
+	}
+	mergeHeap.back().data = shardCursor.current();
+	push_heap(mergeHeap.begin(), mergeHeap.end(), comesAfter);
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[operator<<]-------------------------------------------
+// Description: The overloaded output operator prints every key of the sharded tree in one
+// sorted order, the same output a single BinTree with the same keys would give. It locks
+// every shard (in index order) while it prints, so writers wait until it is done.
+// -------------------------------------------------------------------------------------------
+ostream& operator<<(ostream& out, const ShardedBinTree &shardedTree)
+{
+	vector<unique_lock<mutex>> shardGuards;
+	shardGuards.reserve(shardedTree.shardCount);
+	for (int shardIndex = 0; shardIndex < shardedTree.shardCount; shardIndex++)
+	{
+		shardGuards.emplace_back(shardedTree.shards[shardIndex].lock);
+	}
+
+	for (ShardedBinTree::OrderedCursor cursor(shardedTree); !cursor.isDone(); cursor.advance())
+	{
+		out << *cursor.current() << " ";
+	}
+	out << endl;
+	return out;
+}
+// -------------------------------------------------------------------------------------------
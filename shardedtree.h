@@ -0,0 +1,163 @@
+// ---------------------------- shardedtree.h --------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The shardedtree.h file is the header file for the
+// ShardedBinTree class, a set of NodeData keys split across a fixed number
+// of independent BinTree shards so that many threads can insert, retrieve
+// and erase at the same time. Its output operator and OrderedCursor still
+// see the keys in one globally sorted order.
+// ---------------------------------------------------------------------
+// Notes - Every key belongs to exactly one shard, chosen either by a hash
+// of the key or by which of the sorted range bounds it falls between. Each
+// shard has its own mutex, so threads only wait for each other when they
+// touch the same shard, and the shards sit on separate cache lines. A key
+// hash that the caller has already computed (with hashKey) can be passed
+// in to skip hashing again. The ordered walk is a k-way merge of one
+// BinTree::InorderCursor per shard, using a heap of the shards' current
+// keys. Each shard also counts its keys under its lock, so size does not
+// have to walk the trees. The ordered walk and the bulk methods (makeEmpty
+// and isEmpty) are meant for when no other thread is writing, the output
+// operator locks every shard while it prints.
+// ---------------------------------------------------------------------
+#ifndef SHARDED_TREE_H
+#define SHARDED_TREE_H
+#include "bintree.h"
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+class ShardedBinTree {
+
+    public:
+        // How keys are assigned to shards
+        enum PartitionMode { HASH_PARTITION, RANGE_PARTITION };
+
+    private:
+        // The Shard struct is one independent tree, the lock that guards it, and the number of
+        // keys in it, which is only known while the tree has not been handed out by shardTree.
+        // Each shard gets its own cache line so that locking one does not slow down its neighbours
+        struct alignas(64) Shard {
+            mutable mutex lock;
+            BinTree tree;
+            int keyCount = 0;
+            bool keyCountKnown = true;
+        };
+
+        // The shards, their number, and how keys are assigned to them
+        unique_ptr<Shard[]> shards;
+        int shardCount;
+        PartitionMode partitionMode;
+
+        // For range partitioning, shard i holds the keys from rangeBounds[i - 1] (inclusive)
+        // up to rangeBounds[i] (exclusive), the first and last shards are open ended
+        vector<string> rangeBounds;
+
+    // Helper methods that pick the shard of a key, from the key or from its precomputed hash
+    int shardOfKey(string_view key) const;
+    int shardOfHash(string_view key, size_t keyHash) const;
+
+    // Helper method for retrieve by a string key
+    bool retrieveByKey(string_view targetKey, NodeData* &retrievedNodeData);
+
+    public:
+        // The OrderedCursor class walks the keys of every shard in one sorted order by merging
+        // the shards, no thread may write to the tree while a cursor is walking it
+        class OrderedCursor {
+
+            private:
+                // The HeapEntry struct is the current key of one shard that is not done yet
+                struct HeapEntry {
+                    NodeData* data;
+                    int shardIndex;
+                };
+
+                // One cursor per shard, and a heap of their current keys with the smallest on top
+                vector<BinTree::InorderCursor> shardCursors;
+                vector<HeapEntry> mergeHeap;
+
+            // Heap order that puts the entry with the smallest key on top
+            static bool comesAfter(const HeapEntry &firstEntry, const HeapEntry &secondEntry);
+
+            public:
+                // Starts a cursor at the smallest key of shardedTree
+                explicit OrderedCursor(const ShardedBinTree &shardedTree);
+
+                // isDone is true after the last key, current is the key the cursor is at
+                bool isDone() const;
+                NodeData* current() const;
+
+                // Moves the cursor to the next larger key of any shard
+                void advance();
+        };
+
+        // Builds an empty tree of shardCount hash partitioned shards (at least 1)
+        explicit ShardedBinTree(int shardCount);
+
+        // Builds an empty range partitioned tree, with one more shard than there are bounds,
+        // the bounds are sorted and duplicates dropped
+        explicit ShardedBinTree(vector<string> rangeBounds);
+
+        // The shards hold locks, so a sharded tree is not copied
+        ShardedBinTree(const ShardedBinTree &otherShardedTree) = delete;
+        ShardedBinTree& operator=(const ShardedBinTree &otherShardedTree) = delete;
+
+        // Returns the hash of key that the precomputed hash overloads expect
+        static size_t hashKey(string_view key);
+
+        // Returns the number of shards, the partition mode, and which shard key belongs to
+        int getShardCount() const;
+        PartitionMode getPartitionMode() const;
+        int shardOf(string_view key) const;
+
+        // Insert takes ownership of newNodeData only when it returns true, like BinTree::insert,
+        // the second version takes the key's hashKey (ignored under range partitioning)
+        bool insert(NodeData* newNodeData);
+        bool insert(NodeData* newNodeData, size_t keyHash);
+
+        // Inserts key, only allocating if it is not already in the tree
+        bool emplace(string_view key);
+        bool emplace(string_view key, size_t keyHash);
+
+        // Finds the key and sets retrievedNodeData to the stored node data or nullptr, which
+        // stays valid until the key is erased
+        bool retrieve(const NodeData &targetNodeData, NodeData* &retrievedNodeData);
+        template <class Key, StringKeyOnly<Key> = 0>
+        bool retrieve(const Key &targetKey, NodeData* &retrievedNodeData);
+        bool retrieve(string_view targetKey, size_t keyHash, NodeData* &retrievedNodeData);
+
+        // Removes the key and deletes its node data, returns false if it was not there
+        bool erase(string_view targetKey);
+
+        // makeEmpty deletes every key, isEmpty checks for keys, size counts them
+        void makeEmpty();
+        bool isEmpty() const;
+        int size() const;
+
+        // Gives direct access to one shard's tree, for a thread that owns that shard, size then
+        // counts that shard's keys by walking its tree until the next makeEmpty
+        BinTree& shardTree(int shardIndex);
+
+        // Prints every key of every shard in one sorted order, followed by a new line
+        friend ostream& operator<<(ostream& out, const ShardedBinTree &shardedTree);
+};
+
+// -------------------------------[string key retrieve]---------------------------------------
+// Description: This overload of retrieve takes the target as any string key type
+// (string_view, const char*, string, ...), like the string key overloads of BinTree.
+// -------------------------------------------------------------------------------------------
+template <class Key, StringKeyOnly<Key>>
+bool ShardedBinTree::retrieve(const Key &targetKey, NodeData* &retrievedNodeData)
+{
+    return retrieveByKey(string_view(targetKey), retrievedNodeData);
+}
+// -------------------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,157 @@
+// ---------------------------- spscqueue.h ----------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The spscqueue.h file defines the SpscQueue class template, a
+// bounded first in first out queue for handing items from exactly one
+// producer thread to exactly one consumer thread without any locks.
+// ---------------------------------------------------------------------
+// Notes - The queue is a ring of slots whose size is a power of two. The
+// producer only writes the tail index and the consumer only writes the
+// head index, each with a release store that the other side reads with
+// an acquire load, and the two indices sit on separate cache lines so the
+// threads do not keep stealing one line from each other. tryPush fails
+// when the ring is full and tryPop fails when it is empty, waiting (and
+// with it backpressure) is left to the caller. close lets the producer
+// say that no more items are coming.
+// ---------------------------------------------------------------------
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+using namespace std;
+
+template <class T>
+class SpscQueue {
+
+    private:
+        // Assumed cache line size, used to keep the two indices apart
+        static const size_t CACHE_LINE_SIZE = 64;
+
+        // The ring of slots, and its size minus one for wrapping an index into it
+        vector<T> slots;
+        size_t indexMask;
+
+        // head counts the items popped so far and tail the items pushed so far, so the queue
+        // holds tail - head items, closed is set once the producer is done
+        alignas(CACHE_LINE_SIZE) atomic<size_t> head;
+        alignas(CACHE_LINE_SIZE) atomic<size_t> tail;
+        alignas(CACHE_LINE_SIZE) atomic<bool> closed;
+
+    public:
+        // Builds an empty queue holding at least capacity items, rounded up to a power of two
+        explicit SpscQueue(size_t capacity);
+
+        // A queue is shared by two threads by reference, it is never copied
+        SpscQueue(const SpscQueue &otherQueue) = delete;
+        SpscQueue& operator=(const SpscQueue &otherQueue) = delete;
+
+        // Producer side, tryPush moves item in unless the queue is full, close ends the stream
+        bool tryPush(T &&item);
+        void close();
+
+        // Consumer side, tryPop moves the oldest item out unless the queue is empty, and
+        // isFinished is true once the queue is closed and every item has been popped
+        bool tryPop(T &item);
+        bool isFinished() const;
+
+        // Returns the number of items the queue can hold
+        size_t capacity() const;
+};
+
+// ------------------------------------[SpscQueue]--------------------------------------------
+// Description: The SpscQueue constructor allocates the ring of slots, with room for at least
+// capacity items (and at least 2), rounded up to the next power of two.
+// -------------------------------------------------------------------------------------------
+template <class T>
+SpscQueue<T>::SpscQueue(size_t capacity) : head(0), tail(0), closed(false)
+{
+    size_t slotCount = 2;
+    while (slotCount < capacity)
+    {
+        slotCount *= 2;
+    }
+    slots.resize(slotCount);
+    indexMask = slotCount - 1;
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[tryPush]---------------------------------------------
+// Description: The tryPush method is called only by the producer thread. It moves item into
+// the next free slot and publishes it to the consumer, or returns false and leaves item
+// untouched if the queue is full.
+// -------------------------------------------------------------------------------------------
+template <class T>
+bool SpscQueue<T>::tryPush(T &&item)
+{
+    size_t currentTail = tail.load(memory_order_relaxed);
+    if (currentTail - head.load(memory_order_acquire) == slots.size())
+    {
+        return false;
+    }
+
+    slots[currentTail & indexMask] = std::move(item);
+    tail.store(currentTail + 1, memory_order_release);
+    return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------------[close]----------------------------------------------
+// Description: The close method is called by the producer thread after its last push, it
+// tells the consumer that the queue will not get any more items.
+// -------------------------------------------------------------------------------------------
+template <class T>
+void SpscQueue<T>::close()
+{
+    closed.store(true, memory_order_release);
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------------[tryPop]---------------------------------------------
+// Description: The tryPop method is called only by the consumer thread. It moves the oldest
+// item of the queue into item and frees its slot for the producer, or returns false if the
+// queue is empty.
+// -------------------------------------------------------------------------------------------
+template <class T>
+bool SpscQueue<T>::tryPop(T &item)
+{
+    size_t currentHead = head.load(memory_order_relaxed);
+    if (currentHead == tail.load(memory_order_acquire))
+    {
+        return false;
+    }
+
+    item = std::move(slots[currentHead & indexMask]);
+    head.store(currentHead + 1, memory_order_release);
+    return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[isFinished]--------------------------------------------
+// Description: The isFinished method is called by the consumer thread when tryPop fails, it
+// returns true if the producer has closed the queue and nothing is left in it. The closed
+// flag is read first, so an item pushed just before close is never missed.
+// -------------------------------------------------------------------------------------------
+template <class T>
+bool SpscQueue<T>::isFinished() const
+{
+    return closed.load(memory_order_acquire) &&
+        head.load(memory_order_relaxed) == tail.load(memory_order_acquire);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------[capacity]--------------------------------------------
+// Description: The capacity method returns the number of items the queue can hold.
+// -------------------------------------------------------------------------------------------
+template <class T>
+size_t SpscQueue<T>::capacity() const
+{
+    return slots.size();
+}
+// -------------------------------------------------------------------------------------------
+
+#endif
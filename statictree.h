@@ -0,0 +1,194 @@
+// ---------------------------- statictree.h ---------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The statictree.h file defines the StaticBinTree class
+// template, an immutable search tree over a fixed set of string keys that
+// is built entirely by the compiler. A tree declared constexpr lives in
+// read-only data, so it costs nothing at startup and never allocates. It
+// has the retrieve and in order iteration interface of BinTree.
+// ---------------------------------------------------------------------
+// Notes - The keys are string_views of the string literals they were
+// given as. The constructor sorts them and lays them out in Eytzinger
+// (breadth-first) order, the same balanced implicit tree FrozenBinTree
+// uses, where the children of slot k are slots 2k and 2k + 1. A duplicate
+// key throws in the constructor, which turns into a compile error when the
+// tree is built in a constant expression. The sort is an insertion sort,
+// which is plenty for keyword sized sets but for thousands of keys can
+// run into the compiler's constexpr step limit. Every lookup is constexpr
+// too, so a static_assert can check a key at compile time. An empty tree
+// is built with the default constructor, since there is no empty array of
+// keys to build it from.
+// ---------------------------------------------------------------------
+#ifndef STATIC_TREE_H
+#define STATIC_TREE_H
+#include "nodedata.h"
+#include "stringkey.h"
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+using namespace std;
+
+template <size_t N>
+class StaticBinTree {
+
+    private:
+        // The keys in sorted order, used for the in order walk
+        array<string_view, N> sortedKeys;
+
+        // The keys in Eytzinger order, slot 0 is unused so the root is slot 1
+        array<string_view, N + 1> layout;
+
+    // Helper method that fills the layout with an inorder walk of the implicit tree
+    constexpr void buildLayout(size_t slot, size_t &nextRank);
+
+    public:
+        // The InorderCursor class walks the keys in sorted order one key per advance, with the
+        // same methods as BinTree::InorderCursor
+        class InorderCursor {
+
+            private:
+                const StaticBinTree* tree;
+                size_t rank;
+
+            public:
+                // Starts a cursor at the smallest key of staticTree
+                constexpr explicit InorderCursor(const StaticBinTree &staticTree) : tree(&staticTree), rank(0) {}
+
+                // isDone is true after the last key, current is the key the cursor is at
+                constexpr bool isDone() const { return rank == N; }
+                constexpr string_view current() const { return tree->sortedKeys[rank]; }
+
+                // Moves the cursor to the next larger key
+                constexpr void advance() { rank++; }
+        };
+
+        // Builds the tree from N keys in any order, throws invalid_argument on a duplicate key
+        constexpr explicit StaticBinTree(const string_view (&keys)[N]);
+
+        // Builds the empty tree, only for N == 0
+        constexpr StaticBinTree();
+
+        // Returns the number of keys and whether there are none
+        constexpr size_t size() const { return N; }
+        constexpr bool isEmpty() const { return N == 0; }
+
+        // Retrieve methods for any string key type or a NodeData, the version with retrievedKey
+        // also sets it to the stored key (which stays valid for the life of the program) or to
+        // an empty view
+        template <class Key, StringKeyOnly<Key> = 0>
+        constexpr bool retrieve(const Key &targetKey) const;
+        constexpr bool retrieve(string_view targetKey, string_view &retrievedKey) const;
+        bool retrieve(const NodeData &targetNodeData) const;
+
+        // The keys in sorted order, for range based for loops
+        constexpr const string_view* begin() const { return sortedKeys.data(); }
+        constexpr const string_view* end() const { return sortedKeys.data() + N; }
+};
+
+// Deduces the number of keys from the array the tree is built from, or 0 for no array
+template <size_t N>
+StaticBinTree(const string_view (&keys)[N]) -> StaticBinTree<N>;
+StaticBinTree() -> StaticBinTree<0>;
+
+// -----------------------------------[StaticBinTree]-----------------------------------------
+// Description: The StaticBinTree constructor sorts the keys with an insertion sort, throws
+// invalid_argument if two neighbours in sorted order are equal, and then fills the
+// Eytzinger layout by walking the implicit tree in order and handing out the sorted keys.
+// The default constructor builds the empty tree, which has nothing to sort or lay out.
+// -------------------------------------------------------------------------------------------
+template <size_t N>
+constexpr StaticBinTree<N>::StaticBinTree(const string_view (&keys)[N]) : sortedKeys{}, layout{}
+{
+    for (size_t i = 0; i < N; i++)
+    {
+        string_view newKey = keys[i];
+        size_t insertAt = i;
+        while (insertAt > 0 && newKey < sortedKeys[insertAt - 1])
+        {
+            sortedKeys[insertAt] = sortedKeys[insertAt - 1];
+            insertAt--;
+        }
+        sortedKeys[insertAt] = newKey;
+    }
+
+    for (size_t i = 1; i < N; i++)
+    {
+        if (sortedKeys[i - 1] == sortedKeys[i])
+        {
+            throw invalid_argument("StaticBinTree keys must be unique");
+        }
+    }
+
+    size_t nextRank = 0;
+    buildLayout(1, nextRank);
+}
+
+template <size_t N>
+constexpr StaticBinTree<N>::StaticBinTree() : sortedKeys{}, layout{}
+{
+    static_assert(N == 0, "only an empty StaticBinTree can be built without keys");
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[buildLayout]-------------------------------------------
+// Description: The buildLayout method visits the subtree of the implicit tree rooted at slot
+// in order, putting the next sorted key in each slot it visits, so the slots end up holding
+// a balanced binary search tree.
+// -------------------------------------------------------------------------------------------
+template <size_t N>
+constexpr void StaticBinTree<N>::buildLayout(size_t slot, size_t &nextRank)
+{
+    if (slot > N)
+    {
+        return;
+    }
+    buildLayout(2 * slot, nextRank);
+    layout[slot] = sortedKeys[nextRank++];
+    buildLayout(2 * slot + 1, nextRank);
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[retrieve]---------------------------------------------
+// Description: The retrieve methods search for targetKey from the root slot, going to slot
+// 2k for a smaller key and 2k + 1 for a larger one, which takes at most log2(N) + 1 string
+// comparisons.
+// -------------------------------------------------------------------------------------------
+template <size_t N>
+template <class Key, StringKeyOnly<Key>>
+constexpr bool StaticBinTree<N>::retrieve(const Key &targetKey) const
+{
+    string_view retrievedKey;
+    return retrieve(string_view(targetKey), retrievedKey);
+}
+
+template <size_t N>
+constexpr bool StaticBinTree<N>::retrieve(string_view targetKey, string_view &retrievedKey) const
+{
+    size_t slot = 1;
+    while (slot <= N)
+    {
+        int comparison = targetKey.compare(layout[slot]);
+        if (comparison == 0)
+        {
+            retrievedKey = layout[slot];
+            return true;
+        }
+        slot = 2 * slot + (comparison > 0 ? 1 : 0);
+    }
+    retrievedKey = string_view();
+    return false;
+}
+
+template <size_t N>
+bool StaticBinTree<N>::retrieve(const NodeData &targetNodeData) const
+{
+    string_view retrievedKey;
+    return retrieve(string_view(targetNodeData.getData()), retrievedKey);
+}
+// -------------------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,26 @@
+// ----------------------------- stringkey.h ---------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The stringkey.h file defines StringKeyOnly, the template
+// constraint that the tree classes use for their overloads that take a
+// plain string key instead of a NodeData.
+// ---------------------------------------------------------------------
+// Notes - It is kept apart from bintree.h so that a class that only needs
+// the constraint, like StaticBinTree, does not pull in all of BinTree.
+// ---------------------------------------------------------------------
+#ifndef STRING_KEY_H
+#define STRING_KEY_H
+#include <string_view>
+#include <type_traits>
+using namespace std;
+
+// StringKeyOnly<Key> enables the string key overloads of the trees for key types
+// that convert to string_view, and keeps them out of overload resolution for
+// everything else, including NodeData
+template <class Key>
+using StringKeyOnly = typename enable_if<is_convertible<const Key&, string_view>::value, int>::type;
+
+#endif
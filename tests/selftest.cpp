@@ -0,0 +1,453 @@
+// --------------------------- selftest.cpp ----------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The selftest.cpp file is a driver that checks the binary
+// search tree classes against std::map on randomized input. It covers
+// insert, erase and counting mode, the set operations, split and join,
+// rebalance, compact, and the page format of PagedBinTree, and prints
+// one line for each check that fails.
+// ---------------------------------------------------------------------
+// Notes - Run as "selftest [seed]", the random keys are drawn from the
+// given seed (1 by default) so that a failure can be repeated. The exit
+// status is 0 when every check passes and 1 otherwise. The keys are short
+// strings over a small alphabet, so the trees share many keys, and some
+// of them start with the same 8 or more bytes, so the prefix compares tie.
+// ---------------------------------------------------------------------
+#include "../bintree.h"
+#include "../pagedtree.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+using namespace std;
+
+// The reference contents of a tree, each key with its count (1 outside counting mode)
+typedef map<string, int> KeyCounts;
+
+const int ROUNDS = 200;
+const char PAGED_FILE_NAME[] = "selftest_paged.bin";
+
+int failureCount = 0;
+
+//global function prototypes
+void check(bool passed, const string& what, int round);
+string randomKey(mt19937& rng);
+void fillTree(BinTree& binTree, KeyCounts& keyCounts, int keyTotal, mt19937& rng);
+bool sameContents(const BinTree& binTree, const KeyCounts& keyCounts);
+void testInsertErase(mt19937& rng);
+void testSetOperations(mt19937& rng);
+void testSplitJoin(mt19937& rng);
+void testRebalanceCompact(mt19937& rng);
+void testPagedTree(mt19937& rng);
+
+int main(int argc, char* argv[])
+{
+	unsigned seed = argc > 1 ? static_cast<unsigned>(strtoul(argv[1], nullptr, 10)) : 1;
+	mt19937 rng(seed);
+
+	testInsertErase(rng);
+	testSetOperations(rng);
+	testSplitJoin(rng);
+	testRebalanceCompact(rng);
+	testPagedTree(rng);
+
+	if (failureCount == 0)
+	{
+		cout << "selftest passed (seed " << seed << ")" << endl;
+		return 0;
+	}
+	cout << "selftest failed " << failureCount << " checks (seed " << seed << ")" << endl;
+	return 1;
+}
+
+// ------------------------------------[check]------------------------------------------------
+// Description: The check global method counts and prints a failed check, naming what was
+// checked and the round it failed in.
+// -------------------------------------------------------------------------------------------
+void check(bool passed, const string& what, int round)
+{
+	if (!passed)
+	{
+		failureCount++;
+		cout << "FAILED: " << what << " (round " << round << ")" << endl;
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[randomKey]----------------------------------------------
+// Description: The randomKey global method returns a key of 1 to 4 letters from "abcd",
+// and one time in four puts "sharedprefix" in front of it, so that keys also tie on the
+// first 8 bytes that the trees compare as integers.
+// -------------------------------------------------------------------------------------------
+string randomKey(mt19937& rng)
+{
+	string key = (rng() % 4 == 0) ? "sharedprefix" : "";
+	int keyLength = 1 + rng() % 4;
+	for (int i = 0; i < keyLength; i++)
+	{
+		key += static_cast<char>('a' + rng() % 4);
+	}
+	return key;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[fillTree]----------------------------------------------
+// Description: The fillTree global method inserts keyTotal random keys into binTree, some of
+// them repeats, and records them in keyCounts the way the tree should count them. It also
+// checks that an insert only reports success for a key that was not in the tree yet.
+// -------------------------------------------------------------------------------------------
+void fillTree(BinTree& binTree, KeyCounts& keyCounts, int keyTotal, mt19937& rng)
+{
+	for (int i = 0; i < keyTotal; i++)
+	{
+		string key = randomKey(rng);
+		bool isNewKey = (keyCounts.count(key) == 0);
+		// Outside counting mode a repeat leaves the count as it is
+		if (isNewKey || binTree.isCountingMode())
+		{
+			keyCounts[key]++;
+		}
+
+		// Half the keys go through emplace, the rest through insert, which leaves the
+		// NodeData of a repeat with the caller
+		bool inserted;
+		if (rng() % 2 == 0)
+		{
+			inserted = binTree.emplace(key);
+		}
+		else
+		{
+			NodeData* newNodeData = new NodeData(key);
+			inserted = binTree.insert(newNodeData);
+			if (!inserted)
+			{
+				delete newNodeData;
+			}
+		}
+		check(inserted == isNewKey, "insert of \"" + key + "\"", i);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[sameContents]--------------------------------------------
+// Description: The sameContents global method returns true if binTree holds exactly the keys
+// of keyCounts, in sorted order, each with the count that keyCounts gives it.
+// -------------------------------------------------------------------------------------------
+bool sameContents(const BinTree& binTree, const KeyCounts& keyCounts)
+{
+	KeyCounts::const_iterator expected = keyCounts.begin();
+	for (BinTree::InorderCursor cursor(binTree); !cursor.isDone(); cursor.advance())
+	{
+		if (expected == keyCounts.end() || cursor.current()->getData() != expected->first ||
+			binTree.count(expected->first) != expected->second)
+		{
+			return false;
+		}
+		++expected;
+	}
+	return expected == keyCounts.end();
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[testInsertErase]-------------------------------------------
+// Description: The testInsertErase global method fills trees in and out of counting mode,
+// then checks retrieve, lowerBound, count and topK against the reference and erases random
+// keys, whatever their counts, checking the contents after every round.
+// -------------------------------------------------------------------------------------------
+void testInsertErase(mt19937& rng)
+{
+	for (int round = 0; round < ROUNDS; round++)
+	{
+		BinTree binTree;
+		KeyCounts keyCounts;
+		binTree.setCountingMode(rng() % 2 == 0);
+		fillTree(binTree, keyCounts, rng() % 400, rng);
+
+		for (int i = 0; i < 50; i++)
+		{
+			string key = randomKey(rng);
+			KeyCounts::const_iterator expected = keyCounts.lower_bound(key);
+			NodeData* retrievedNodeData;
+			check(binTree.retrieve(key, retrievedNodeData) == (keyCounts.count(key) == 1),
+				"retrieve of \"" + key + "\"", round);
+			NodeData* lowerBoundNodeData = binTree.lowerBound(NodeData(key));
+			check(expected == keyCounts.end() ? lowerBoundNodeData == nullptr :
+				lowerBoundNodeData != nullptr && lowerBoundNodeData->getData() == expected->first,
+				"lowerBound of \"" + key + "\"", round);
+		}
+
+		// topK lists the largest counts first, and equal counts in key order
+		vector<pair<NodeData*, int>> frequentKeys = binTree.topK(5);
+		multimap<int, string, greater<int>> byCount;
+		for (KeyCounts::const_iterator entry = keyCounts.begin(); entry != keyCounts.end(); ++entry)
+		{
+			byCount.emplace(entry->second, entry->first);
+		}
+		bool topKMatches = (frequentKeys.size() == min<size_t>(5, keyCounts.size()));
+		multimap<int, string, greater<int>>::const_iterator expected = byCount.begin();
+		for (size_t i = 0; topKMatches && i < frequentKeys.size(); i++, ++expected)
+		{
+			topKMatches = frequentKeys[i].first->getData() == expected->second &&
+				frequentKeys[i].second == expected->first;
+		}
+		check(topKMatches, "topK", round);
+
+		for (int i = 0; i < 100; i++)
+		{
+			string key = randomKey(rng);
+			check(binTree.erase(key) == (keyCounts.erase(key) == 1), "erase of \"" + key + "\"", round);
+		}
+		check(sameContents(binTree, keyCounts), "contents after insert and erase", round);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------[testSetOperations]------------------------------------------
+// Description: The testSetOperations global method applies unionWith, intersect and
+// difference to random pairs of trees, each in or out of counting mode and some of them
+// compacted, and compares the result with the same operation on the reference. A union
+// adds the counts of a key in both trees (in a counting tree), an intersection keeps the
+// smaller count, and the other tree is always left empty.
+// -------------------------------------------------------------------------------------------
+void testSetOperations(mt19937& rng)
+{
+	for (int round = 0; round < ROUNDS; round++)
+	{
+		BinTree binTree, otherBinTree;
+		KeyCounts keyCounts, otherKeyCounts;
+		binTree.setCountingMode(rng() % 2 == 0);
+		otherBinTree.setCountingMode(rng() % 2 == 0);
+		fillTree(binTree, keyCounts, rng() % 300, rng);
+		fillTree(otherBinTree, otherKeyCounts, rng() % 300, rng);
+		if (rng() % 3 == 0)
+		{
+			binTree.compact();
+		}
+		if (rng() % 3 == 0)
+		{
+			otherBinTree.compact();
+		}
+
+		KeyCounts resultCounts;
+		int operation = rng() % 3;
+		if (operation == 0)
+		{
+			resultCounts = keyCounts;
+			for (KeyCounts::const_iterator entry = otherKeyCounts.begin(); entry != otherKeyCounts.end(); ++entry)
+			{
+				bool inBoth = keyCounts.count(entry->first) == 1;
+				resultCounts[entry->first] = !inBoth ? entry->second :
+					binTree.isCountingMode() ? keyCounts[entry->first] + entry->second : 1;
+			}
+			binTree.unionWith(otherBinTree);
+			check(sameContents(binTree, resultCounts), "unionWith", round);
+		}
+		else if (operation == 1)
+		{
+			for (KeyCounts::const_iterator entry = keyCounts.begin(); entry != keyCounts.end(); ++entry)
+			{
+				if (otherKeyCounts.count(entry->first) == 1)
+				{
+					resultCounts[entry->first] = min(entry->second, otherKeyCounts[entry->first]);
+				}
+			}
+			binTree.intersect(otherBinTree);
+			check(sameContents(binTree, resultCounts), "intersect", round);
+		}
+		else
+		{
+			resultCounts = keyCounts;
+			for (KeyCounts::const_iterator entry = otherKeyCounts.begin(); entry != otherKeyCounts.end(); ++entry)
+			{
+				resultCounts.erase(entry->first);
+			}
+			binTree.difference(otherBinTree);
+			check(sameContents(binTree, resultCounts), "difference", round);
+		}
+		check(otherBinTree.isEmpty(), "other tree left empty", round);
+
+		// The result is still a working tree
+		fillTree(binTree, resultCounts, 50, rng);
+		check(sameContents(binTree, resultCounts), "insert after a set operation", round);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[testSplitJoin]--------------------------------------------
+// Description: The testSplitJoin global method splits random trees at a random key, checks
+// both halves, joins them back into a tree that may count differently, and checks that a
+// join of overlapping trees is refused without changing them.
+// -------------------------------------------------------------------------------------------
+void testSplitJoin(mt19937& rng)
+{
+	for (int round = 0; round < ROUNDS; round++)
+	{
+		BinTree binTree, lessTree, greaterTree, joinedTree;
+		KeyCounts keyCounts, lessCounts, greaterCounts;
+		binTree.setCountingMode(rng() % 2 == 0);
+		lessTree.setCountingMode(rng() % 2 == 0);
+		greaterTree.setCountingMode(rng() % 2 == 0);
+		joinedTree.setCountingMode(binTree.isCountingMode());
+		fillTree(binTree, keyCounts, rng() % 400, rng);
+
+		string splitKey = randomKey(rng);
+		for (KeyCounts::const_iterator entry = keyCounts.begin(); entry != keyCounts.end(); ++entry)
+		{
+			(entry->first < splitKey ? lessCounts : greaterCounts)[entry->first] = entry->second;
+		}
+		binTree.split(NodeData(splitKey), lessTree, greaterTree);
+		check(binTree.isEmpty(), "split leaves the tree empty", round);
+		check(sameContents(lessTree, lessCounts), "split keys less than \"" + splitKey + "\"", round);
+		check(sameContents(greaterTree, greaterCounts), "split keys from \"" + splitKey + "\"", round);
+
+		// Joining the halves in the wrong order overlaps unless one of them is empty
+		if (!lessCounts.empty() && !greaterCounts.empty())
+		{
+			check(!joinedTree.join(greaterTree, lessTree), "join of overlapping trees is refused", round);
+			check(sameContents(lessTree, lessCounts) && sameContents(greaterTree, greaterCounts),
+				"refused join changes nothing", round);
+		}
+
+		check(joinedTree.join(lessTree, greaterTree), "join of the split halves", round);
+		check(lessTree.isEmpty() && greaterTree.isEmpty(), "join leaves the halves empty", round);
+		check(sameContents(joinedTree, keyCounts), "join gives back the split tree", round);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------[testRebalanceCompact]-----------------------------------------
+// Description: The testRebalanceCompact global method builds trees, some from keys in sorted
+// order so they start out as a path, then checks that rebalance reaches the optimal height
+// and that compact lays every node out next to its NodeData, both without changing the keys
+// or counts, and that copies and later inserts and erases still work.
+// -------------------------------------------------------------------------------------------
+void testRebalanceCompact(mt19937& rng)
+{
+	for (int round = 0; round < ROUNDS; round++)
+	{
+		BinTree binTree;
+		KeyCounts keyCounts;
+		binTree.setCountingMode(rng() % 2 == 0);
+		if (round % 4 == 0)
+		{
+			int keyTotal = rng() % 300;
+			for (int i = 0; i < keyTotal; i++)
+			{
+				string key = "sorted" + to_string(1000 + i);
+				binTree.emplace(key);
+				keyCounts[key] = 1;
+			}
+		}
+		else
+		{
+			fillTree(binTree, keyCounts, rng() % 400, rng);
+		}
+
+		binTree.rebalance();
+		ShapeStats shape = binTree.shapeStats();
+		check(shape.nodeCount == static_cast<int>(keyCounts.size()), "node count after rebalance", round);
+		check(shape.height == shape.optimalHeight, "rebalance reaches the optimal height", round);
+		check(sameContents(binTree, keyCounts), "contents after rebalance", round);
+
+		CompactionStats compaction = binTree.compact();
+		check(compaction.after.nodeCount == static_cast<int>(keyCounts.size()), "node count after compact", round);
+		check(keyCounts.empty() || compaction.after.averageDataDistance < 64, "compact puts the NodeData next to its node", round);
+		check(sameContents(binTree, keyCounts), "contents after compact", round);
+
+		// A compacted tree is copied, changed and compacted again like any other
+		BinTree copiedTree(binTree);
+		check(sameContents(copiedTree, keyCounts), "copy of a compacted tree", round);
+		fillTree(binTree, keyCounts, 100, rng);
+		for (int i = 0; i < 50; i++)
+		{
+			string key = randomKey(rng);
+			check(binTree.erase(key) == (keyCounts.erase(key) == 1), "erase after compact", round);
+		}
+		binTree.compact();
+		check(sameContents(binTree, keyCounts), "contents after a second compact", round);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[testPagedTree]--------------------------------------------
+// Description: The testPagedTree global method builds a PagedBinTree with the smallest
+// cache, so pages are written and read back all the time, and checks it against the
+// reference. It then closes the file, reopens it with a different cache size to read the
+// pages as they are stored, and finally overwrites every page but the header with garbage
+// to check that the tree reports the error instead of following it.
+// -------------------------------------------------------------------------------------------
+void testPagedTree(mt19937& rng)
+{
+	const int pagedRounds = 4;
+	for (int round = 0; round < pagedRounds; round++)
+	{
+		KeyCounts keyCounts;
+		{
+			PagedBinTree pagedTree;
+			check(pagedTree.create(PAGED_FILE_NAME, PagedBinTree::MIN_CACHE_PAGES), "create", round);
+			for (int i = 0; i < 5000; i++)
+			{
+				// Longer keys than randomKey gives fill pages and split them sooner
+				string key = randomKey(rng) + string(rng() % 200, 'x') + to_string(rng() % 3000);
+				bool isNewKey = keyCounts.emplace(key, 1).second;
+				check(pagedTree.insert(NodeData(key)) == isNewKey, "paged insert", round);
+			}
+			check(!pagedTree.insert(NodeData(string(PagedBinTree::MAX_KEY_BYTES + 1, 'k'))),
+				"paged insert of a key that is too long", round);
+			check(pagedTree.size() == keyCounts.size(), "paged size", round);
+			check(pagedTree.close(), "paged close", round);
+		}
+
+		PagedBinTree pagedTree;
+		check(pagedTree.open(PAGED_FILE_NAME, PagedBinTree::MIN_CACHE_PAGES + round), "open", round);
+		check(pagedTree.size() == keyCounts.size(), "paged size after reopening", round);
+		check(pagedTree.getHeight() > 1, "paged tree has inner pages", round);
+
+		// The cursor gives back every key in order, also from a key in the middle
+		KeyCounts::const_iterator expected = keyCounts.begin();
+		bool cursorMatches = true;
+		for (PagedBinTree::InorderCursor cursor(pagedTree); !cursor.isDone(); cursor.advance(), ++expected)
+		{
+			cursorMatches = cursorMatches && expected != keyCounts.end() && cursor.current() == expected->first;
+		}
+		check(cursorMatches && expected == keyCounts.end(), "paged cursor order", round);
+
+		string startKey = randomKey(rng);
+		PagedBinTree::InorderCursor startCursor(pagedTree, startKey);
+		expected = keyCounts.lower_bound(startKey);
+		check(expected == keyCounts.end() ? startCursor.isDone() :
+			!startCursor.isDone() && startCursor.current() == expected->first, "paged cursor start", round);
+
+		for (int i = 0; i < 500; i++)
+		{
+			string key = randomKey(rng) + string(rng() % 200, 'x') + to_string(rng() % 3000);
+			check(pagedTree.retrieve(NodeData(key)) == (keyCounts.count(key) == 1), "paged retrieve", round);
+		}
+		check(!pagedTree.hasError(), "no paged error on a good file", round);
+		pagedTree.close();
+
+		// Every page after the header is now garbage, a lookup must fail and say so
+		fstream pagedFile(PAGED_FILE_NAME, ios::in | ios::out | ios::binary);
+		pagedFile.seekp(0, ios::end);
+		streamoff fileBytes = pagedFile.tellp();
+		string garbage(PagedBinTree::PAGE_SIZE, '\xff');
+		for (streamoff offset = PagedBinTree::PAGE_SIZE; offset < fileBytes; offset += PagedBinTree::PAGE_SIZE)
+		{
+			pagedFile.seekp(offset);
+			pagedFile.write(garbage.data(), garbage.size());
+		}
+		pagedFile.close();
+
+		PagedBinTree corruptTree;
+		check(corruptTree.open(PAGED_FILE_NAME, PagedBinTree::MIN_CACHE_PAGES), "open with a good header", round);
+		check(!corruptTree.retrieve(NodeData(keyCounts.begin()->first)), "retrieve from a corrupt page", round);
+		check(corruptTree.hasError(), "corrupt page is reported", round);
+	}
+	remove(PAGED_FILE_NAME);
+}
+// -------------------------------------------------------------------------------------------
@@ -0,0 +1,560 @@
+// ---------------------------- widetree.cpp ---------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The widetree.cpp file is the implementation file for the
+// WideBinTree class, a B-tree style search tree whose nodes each hold up
+// to 16 keys, searched by comparing packed key prefixes all at once.
+// ---------------------------------------------------------------------
+// Notes - Insert splits any full node it passes on the way down (the
+// median key moves up into the parent), so the leaf it reaches always has
+// room and the tree stays perfectly balanced. The search inside a node
+// counts how many prefixes are below and how many are at most the target's
+// prefix, and only the keys in between (prefix ties) are compared in full.
+// ---------------------------------------------------------------------
+#include "widetree.h"
+#include <iostream>
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// ----------------------------------[countBits]----------------------------------------------
+// Description: The countBits function returns the number of set bits in mask.
+// -------------------------------------------------------------------------------------------
+static inline int countBits(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcount(mask);
+#else
+	int bitCount = 0;
+	while (mask != 0)
+	{
+		mask &= mask - 1;
+		bitCount++;
+	}
+	return bitCount;
+#endif
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[comparePrefixes]-------------------------------------------
+// Description: The comparePrefixes function compares targetPrefix with all 16 prefixes of a
+// wide node at once. Bit i of lessMask is set when prefixes[i] < targetPrefix and bit i of
+// lessEqualMask is set when prefixes[i] <= targetPrefix. The vector instructions only
+// compare signed integers, so the sign bit of both sides is flipped first to get the
+// unsigned order.
+// -------------------------------------------------------------------------------------------
+static inline void comparePrefixes(const uint64_t* prefixes, uint64_t targetPrefix, unsigned& lessMask, unsigned& lessEqualMask)
+{
+	lessMask = 0;
+	lessEqualMask = 0;
+
+#if defined(__AVX2__)
+	const __m256i signBit = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+	const __m256i target = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(targetPrefix)), signBit);
+	for (int i = 0; i < 16; i += 4)
+	{
+		__m256i keys = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(prefixes + i)), signBit);
+		unsigned less = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(target, keys))));
+		unsigned greater = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(keys, target))));
+		lessMask |= less << i;
+		lessEqualMask |= (~greater & 0xFu) << i;
+	}
+#elif defined(__SSE4_2__)
+	const __m128i signBit = _mm_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+	const __m128i target = _mm_xor_si128(_mm_set1_epi64x(static_cast<long long>(targetPrefix)), signBit);
+	for (int i = 0; i < 16; i += 2)
+	{
+		__m128i keys = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(prefixes + i)), signBit);
+		unsigned less = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(target, keys))));
+		unsigned greater = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(keys, target))));
+		lessMask |= less << i;
+		lessEqualMask |= (~greater & 0x3u) << i;
+	}
+#else
+	for (int i = 0; i < 16; i++)
+	{
+		lessMask |= static_cast<unsigned>(prefixes[i] < targetPrefix) << i;
+		lessEqualMask |= static_cast<unsigned>(prefixes[i] <= targetPrefix) << i;
+	}
+#endif
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------[Default Constructor]-----------------------------------------
+// Description: The default constructor for the WideBinTree class initializes an empty
+// tree by setting the root of the tree to nullptr.
+// -------------------------------------------------------------------------------------------
+WideBinTree::WideBinTree()
+{
+	root = nullptr;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------[Copy Constructor]-------------------------------------------
+// Description: The copy constructor for the WideBinTree class creates a deep copy of
+// otherWideTree, with the same node structure and copies of all of its node data.
+// -------------------------------------------------------------------------------------------
+WideBinTree::WideBinTree(const WideBinTree &otherWideTree)
+{
+	root = nullptr;
+	copyHelper(root, otherWideTree.root);
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[Destructor]----------------------------------------------
+// Description: The destructor of the WideBinTree class frees all of the nodes and node data
+// in the tree by calling the makeEmpty method.
+// -------------------------------------------------------------------------------------------
+WideBinTree::~WideBinTree()
+{
+	makeEmpty();
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[makeEmpty]-----------------------------------------------
+// Description: The makeEmpty method removes every node from the tree and deallocates the
+// nodes and their node data by calling the emptyWideTreeHelper method.
+// -------------------------------------------------------------------------------------------
+void WideBinTree::makeEmpty()
+{
+	emptyWideTreeHelper(root);
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------[emptyWideTreeHelper]------------------------------------------
+// Description: The emptyWideTreeHelper method is the helper method for the makeEmpty method,
+// it recursively deletes the children of node, then the node data of node, then node itself.
+// -------------------------------------------------------------------------------------------
+void WideBinTree::emptyWideTreeHelper(WideNode* &node)
+{
+	if (node == nullptr)
+	{
+		return;
+	}
+
+	// A leaf has no children to delete, an internal node has one more child than keys
+	if (!node->isLeaf)
+	{
+		for (int i = 0; i <= node->keyCount; i++)
+		{
+			emptyWideTreeHelper(node->children[i]);
+		}
+	}
+
+	for (int i = 0; i < node->keyCount; i++)
+	{
+		delete node->keys[i];
+	}
+	delete node;
+	node = nullptr;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[copyHelper]----------------------------------------------
+// Description: The copyHelper method is the helper method for the copy constructor and the
+// assignment operator, it recursively creates a copy of otherNode and its children.
+// -------------------------------------------------------------------------------------------
+void WideBinTree::copyHelper(WideNode* &newNode, const WideNode* otherNode) const
+{
+	if (otherNode == nullptr)
+	{
+		newNode = nullptr;
+		return;
+	}
+
+	// Copy the prefixes and the layout of the node, then give it its own copies of the keys
+	newNode = new WideNode(*otherNode);
+	for (int i = 0; i < otherNode->keyCount; i++)
+	{
+		newNode->keys[i] = new NodeData(*otherNode->keys[i]);
+	}
+
+	if (!otherNode->isLeaf)
+	{
+		for (int i = 0; i <= otherNode->keyCount; i++)
+		{
+			copyHelper(newNode->children[i], otherNode->children[i]);
+		}
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[isEmpty]----------------------------------------------
+// Description: The isEmpty method returns true if the tree has no keys, false otherwise.
+// -------------------------------------------------------------------------------------------
+bool WideBinTree::isEmpty() const
+{
+	return root == nullptr;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator=]----------------------------------------------
+// Description: The overloaded assignment operator replaces the contents of this tree with
+// a deep copy of otherWideTree, self-assignment leaves the tree unchanged.
+// -------------------------------------------------------------------------------------------
+WideBinTree& WideBinTree::operator=(const WideBinTree &otherWideTree)
+{
+	if (this != &otherWideTree)
+	{
+		makeEmpty();
+		copyHelper(root, otherWideTree.root);
+	}
+	return *this;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator==]---------------------------------------------
+// Description: The overloaded equality operator returns true if both trees have the same
+// node structure and the same node data in every node.
+// -------------------------------------------------------------------------------------------
+bool WideBinTree::operator==(const WideBinTree &otherWideTree) const
+{
+	return equalityHelper(root, otherWideTree.root);
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator!=]---------------------------------------------
+// Description: The overloaded inequality operator returns true if the trees differ in
+// structure or in any node data.
+// -------------------------------------------------------------------------------------------
+bool WideBinTree::operator!=(const WideBinTree &otherWideTree) const
+{
+	return !(*this == otherWideTree);
+}
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------[equalityHelper]--------------------------------------------
+// Description: The equalityHelper method recursively compares two nodes, their keys and
+// their children for the overloaded equality operator.
+// -------------------------------------------------------------------------------------------
+bool WideBinTree::equalityHelper(const WideNode* currentNode, const WideNode* otherNode) const
+{
+	if (currentNode == nullptr || otherNode == nullptr)
+	{
+		return currentNode == otherNode;
+	}
+
+	if (currentNode->keyCount != otherNode->keyCount || currentNode->isLeaf != otherNode->isLeaf)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < currentNode->keyCount; i++)
+	{
+		if (*currentNode->keys[i] != *otherNode->keys[i])
+		{
+			return false;
+		}
+	}
+
+	if (!currentNode->isLeaf)
+	{
+		for (int i = 0; i <= currentNode->keyCount; i++)
+		{
+			if (!equalityHelper(currentNode->children[i], otherNode->children[i]))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[operator<<]---------------------------------------------
+// Description: The overloaded output operator prints the keys of the tree in sorted order
+// separated by spaces, followed by a newline.
+// -------------------------------------------------------------------------------------------
+ostream& operator<<(ostream& out, const WideBinTree &wideTree)
+{
+	wideTree.inorderHelper(out, wideTree.root);
+	out << endl;
+	return out;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[inorderHelper]-------------------------------------------
+// Description: The inorderHelper method prints the keys under node in sorted order by
+// alternating between the children and the keys of the node.
+// -------------------------------------------------------------------------------------------
+void WideBinTree::inorderHelper(ostream& out, const WideNode* node) const
+{
+	if (node == nullptr)
+	{
+		return;
+	}
+
+	for (int i = 0; i < node->keyCount; i++)
+	{
+		if (!node->isLeaf)
+		{
+			inorderHelper(out, node->children[i]);
+		}
+		out << *node->keys[i] << " ";
+	}
+
+	if (!node->isLeaf)
+	{
+		inorderHelper(out, node->children[node->keyCount]);
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------------[findKeyIndex]--------------------------------------------
+// Description: The findKeyIndex method returns the index of the first key in node that is
+// not less than targetNodeData, and sets found to whether that key is equal to it. The
+// prefix comparison gives the range of keys whose prefix ties with targetPrefix, and only
+// the keys in that range are compared as NodeData.
+// -------------------------------------------------------------------------------------------
+int WideBinTree::findKeyIndex(const WideNode* node, const NodeData& targetNodeData, uint64_t targetPrefix, bool& found) const
+{
+	unsigned lessMask;
+	unsigned lessEqualMask;
+	comparePrefixes(node->prefixes, targetPrefix, lessMask, lessEqualMask);
+
+	// Ignore the unused prefix slots past the last key
+	unsigned usedMask = (1u << node->keyCount) - 1;
+	int keyIndex = countBits(lessMask & usedMask);
+	int tieEnd = countBits(lessEqualMask & usedMask);
+
+	// Walk through the keys whose prefix equals the target's prefix
+	while (keyIndex < tieEnd && *node->keys[keyIndex] < targetNodeData)
+	{
+		keyIndex++;
+	}
+
+	found = keyIndex < tieEnd && *node->keys[keyIndex] == targetNodeData;
+	return keyIndex;
+}
+// -------------------------------------------------------------------------------------------
+
+// ----------------------------------[splitChild]---------------------------------------------
+// Description: The splitChild method splits the full child at childIndex of parentNode into
+// two nodes, the median key of the child moves up into parentNode between the two halves.
+// parentNode must not be full.
+// -------------------------------------------------------------------------------------------
+void WideBinTree::splitChild(WideNode* parentNode, int childIndex)
+{
+	WideNode* fullChild = parentNode->children[childIndex];
+	WideNode* rightHalf = new WideNode();
+	const int medianIndex = MAX_KEYS / 2;
+
+	// The keys after the median, and the children after the median key, move to the right half
+	rightHalf->isLeaf = fullChild->isLeaf;
+	rightHalf->keyCount = MAX_KEYS - medianIndex - 1;
+	for (int i = 0; i < rightHalf->keyCount; i++)
+	{
+		rightHalf->keys[i] = fullChild->keys[medianIndex + 1 + i];
+		rightHalf->prefixes[i] = fullChild->prefixes[medianIndex + 1 + i];
+	}
+	if (!fullChild->isLeaf)
+	{
+		for (int i = 0; i <= rightHalf->keyCount; i++)
+		{
+			rightHalf->children[i] = fullChild->children[medianIndex + 1 + i];
+		}
+	}
+	fullChild->keyCount = medianIndex;
+
+	// Open a gap in the parent for the median key and the new right child
+	for (int i = parentNode->keyCount; i > childIndex; i--)
+	{
+		parentNode->keys[i] = parentNode->keys[i - 1];
+		parentNode->prefixes[i] = parentNode->prefixes[i - 1];
+		parentNode->children[i + 1] = parentNode->children[i];
+	}
+	parentNode->keys[childIndex] = fullChild->keys[medianIndex];
+	parentNode->prefixes[childIndex] = fullChild->prefixes[medianIndex];
+	parentNode->children[childIndex + 1] = rightHalf;
+	parentNode->keyCount++;
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[insert]-----------------------------------------------
+// Description: The insert method inserts newNodeData into the tree and returns true, or
+// returns false without taking ownership of newNodeData if an equal key is already in the
+// tree. Every full node met on the way down is split first, so the leaf that is reached
+// always has room for the new key.
+// -------------------------------------------------------------------------------------------
+bool WideBinTree::insert(NodeData* newNodeData)
+{
+	const uint64_t newPrefix = newNodeData->getPrefix();
+
+	// The first key becomes a leaf root
+	if (root == nullptr)
+	{
+		root = new WideNode();
+		root->isLeaf = true;
+		root->keys[0] = newNodeData;
+		root->prefixes[0] = newPrefix;
+		root->keyCount = 1;
+		return true;
+	}
+
+	// A full root is split under a new root, which is the only way the tree grows taller
+	if (root->keyCount == MAX_KEYS)
+	{
+		WideNode* newRoot = new WideNode();
+		newRoot->isLeaf = false;
+		newRoot->children[0] = root;
+		root = newRoot;
+		splitChild(root, 0);
+	}
+
+	WideNode* currentNode = root;
+	for (;;)
+	{
+		bool found;
+		int keyIndex = findKeyIndex(currentNode, *newNodeData, newPrefix, found);
+		if (found)
+		{
+			return false;
+		}
+
+		// In a leaf, shift the larger keys over and put the new key in its place
+		if (currentNode->isLeaf)
+		{
+			for (int i = currentNode->keyCount; i > keyIndex; i--)
+			{
+				currentNode->keys[i] = currentNode->keys[i - 1];
+				currentNode->prefixes[i] = currentNode->prefixes[i - 1];
+			}
+			currentNode->keys[keyIndex] = newNodeData;
+			currentNode->prefixes[keyIndex] = newPrefix;
+			currentNode->keyCount++;
+			return true;
+		}
+
+		// Split a full child before descending into it, the median that moved up may be the
+		// new key itself or may send the descent into the new right half
+		if (currentNode->children[keyIndex]->keyCount == MAX_KEYS)
+		{
+			splitChild(currentNode, keyIndex);
+			if (*newNodeData == *currentNode->keys[keyIndex])
+			{
+				return false;
+			}
+			if (*newNodeData > *currentNode->keys[keyIndex])
+			{
+				keyIndex++;
+			}
+		}
+		currentNode = currentNode->children[keyIndex];
+	}
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[retrieve]----------------------------------------------
+// Description: The retrieve method searches the tree for targetNodeData, it sets
+// retrievedNodeData to the stored node data and returns true if it was found, otherwise it
+// sets retrievedNodeData to nullptr and returns false.
+// -------------------------------------------------------------------------------------------
+bool WideBinTree::retrieve(const NodeData& targetNodeData, NodeData* &retrievedNodeData)
+{
+	const uint64_t targetPrefix = targetNodeData.getPrefix();
+	WideNode* currentNode = root;
+
+	while (currentNode != nullptr)
+	{
+		bool found;
+		int keyIndex = findKeyIndex(currentNode, targetNodeData, targetPrefix, found);
+		if (found)
+		{
+			retrievedNodeData = currentNode->keys[keyIndex];
+			return true;
+		}
+
+		// The target can only be in the child between the keys that surround it
+		currentNode = currentNode->isLeaf ? nullptr : currentNode->children[keyIndex];
+	}
+
+	retrievedNodeData = nullptr;
+	return false;
+}
+// -------------------------------------------------------------------------------------------
+
+// -----------------------------------[getHeight]---------------------------------------------
+// Description: The getHeight method returns the number of node levels from the wide node
+// that holds nodeData down to the leaves (1 for a key in a leaf), or 0 if nodeData is not in
+// the tree. Every leaf is at the same depth, so one path down is enough.
+// -------------------------------------------------------------------------------------------
+int WideBinTree::getHeight(const NodeData &nodeData) const
+{
+	const uint64_t targetPrefix = nodeData.getPrefix();
+	const WideNode* currentNode = root;
+
+	while (currentNode != nullptr)
+	{
+		bool found;
+		int keyIndex = findKeyIndex(currentNode, nodeData, targetPrefix, found);
+		if (found)
+		{
+			return getHeightRecursiveHelper(currentNode);
+		}
+		currentNode = currentNode->isLeaf ? nullptr : currentNode->children[keyIndex];
+	}
+	return 0;
+}
+// -------------------------------------------------------------------------------------------
+
+// ---------------------------[getHeightRecursiveHelper]--------------------------------------
+// Description: The getHeightRecursiveHelper method returns the number of levels from node
+// down to the leaves by following the first child.
+// -------------------------------------------------------------------------------------------
+int WideBinTree::getHeightRecursiveHelper(const WideNode* node) const
+{
+	if (node->isLeaf)
+	{
+		return 1;
+	}
+	return getHeightRecursiveHelper(node->children[0]) + 1;
+}
+// -------------------------------------------------------------------------------------------
+
+// --------------------------------[displaySideways]------------------------------------------
+// Description: The displaySideways method displays the tree from its side by calling the
+// sideways method, the keys of one wide node are printed at the same indentation.
+// -------------------------------------------------------------------------------------------
+void WideBinTree::displaySideways() const
+{
+	sideways(root, 0);
+}
+// -------------------------------------------------------------------------------------------
+
+// ------------------------------------[sideways]---------------------------------------------
+// Description: The sideways method is the recursive helper method for displaySideways, it
+// prints the largest keys first so that the tree reads sideways with its root on the left.
+// -------------------------------------------------------------------------------------------
+void WideBinTree::sideways(const WideNode* current, int level) const
+{
+	if (current == nullptr)
+	{
+		return;
+	}
+	level++;
+
+	for (int i = current->keyCount - 1; i >= 0; i--)
+	{
+		if (!current->isLeaf)
+		{
+			sideways(current->children[i + 1], level);
+		}
+
+		// 4 Spaces are outputted for each depth level for readability
+		for (int j = level; j >= 0; j--)
+		{
+			cout << "    ";
+		}
+		cout << *current->keys[i] << endl;
+	}
+
+	if (!current->isLeaf)
+	{
+		sideways(current->children[0], level);
+	}
+}
+// -------------------------------------------------------------------------------------------
@@ -0,0 +1,87 @@
+// ----------------------------- widetree.h ----------------------------
+// David Schurer
+// CSS 343
+// Creation Date: 10/19/2026
+// Date of Last Modification: 10/19/2026
+// ---------------------------------------------------------------------
+// Purpose - The widetree.h file is the header file for the WideBinTree
+// class, an alternative search tree engine with the same insert, retrieve,
+// getHeight and output interface as BinTree. Instead of one key and two
+// pointers per node, each node holds up to 16 keys and 17 children, like
+// a B-tree, so a lookup touches far fewer nodes and cache lines.
+// ---------------------------------------------------------------------
+// Notes - Each wide node keeps the first 8 bytes of its keys as integers
+// in one array, and the search inside a node compares the target's prefix
+// with all of them at once using AVX2 or SSE4.2 when the compiler targets
+// them (e.g. -mavx2), falling back to a plain loop otherwise. The NodeData
+// objects are only compared when the target's prefix ties with a key's.
+// ---------------------------------------------------------------------
+#ifndef WIDE_TREE_H
+#define WIDE_TREE_H
+#include "nodedata.h"
+#include <cstdint>
+#include <iostream>
+using namespace std;
+
+class WideBinTree {
+
+    private:
+        // Maximum number of keys held by one wide node
+        static const int MAX_KEYS = 16;
+
+        // The WideNode struct defines a node of the wide tree, the prefixes array holds the
+        // packed first 8 bytes of each key, keys holds the NodeData of each key in sorted order,
+        // and children[i] holds the keys that fall between keys[i - 1] and keys[i]
+        struct alignas(64) WideNode {
+            uint64_t prefixes[MAX_KEYS];
+            NodeData* keys[MAX_KEYS];
+            WideNode* children[MAX_KEYS + 1];
+            int keyCount;
+            bool isLeaf;
+        };
+
+        // Pointer to the root node of the wide tree
+        WideNode* root;
+
+    // Helper methods for the destructor, the copy constructor, and the overloaded operators
+    void emptyWideTreeHelper(WideNode* &node);
+    void copyHelper(WideNode* &newNode, const WideNode* otherNode) const;
+    bool equalityHelper(const WideNode* currentNode, const WideNode* otherNode) const;
+    void inorderHelper(ostream& out, const WideNode* node) const;
+    void sideways(const WideNode* current, int level) const;
+
+    // Helper methods for searching inside a node and splitting a full node during insert
+    int findKeyIndex(const WideNode* node, const NodeData& targetNodeData, uint64_t targetPrefix, bool& found) const;
+    void splitChild(WideNode* parentNode, int childIndex);
+    int getHeightRecursiveHelper(const WideNode* node) const;
+
+    public:
+        // Wide tree constructor, copy constructor, and destructor
+        WideBinTree();
+        WideBinTree(const WideBinTree &otherWideTree);
+        ~WideBinTree();
+
+        // makeEmpty deletes all of the nodes and node data in the tree
+        void makeEmpty();
+
+        // isEmpty checks to see if the tree is empty
+        bool isEmpty() const;
+
+        // Overloaded =, ==, !=, << operators
+        WideBinTree& operator=(const WideBinTree &otherWideTree);
+        bool operator==(const WideBinTree &otherWideTree) const;
+        bool operator!=(const WideBinTree &otherWideTree) const;
+        friend ostream& operator<<(ostream& out, const WideBinTree &wideTree);
+
+        // Insert and retrieve methods, insert takes ownership of newNodeData only when it returns true
+        bool insert(NodeData* newNodeData);
+        bool retrieve(const NodeData &targetNodeData, NodeData* &retrievedNodeData);
+
+        // Method to display the tree sideways, the keys of one wide node share an indentation
+        void displaySideways() const;
+
+        // Returns the number of node levels from the wide node holding nodeData down to the leaves
+        int getHeight(const NodeData &nodeData) const;
+};
+
+#endif